@@ -4,7 +4,14 @@
 layout(location = 0) in vec3 a_Position;
 
 uniform mat4 u_Model;
-uniform mat4 u_ProjectionView;
+
+layout(std140) uniform FrameData
+{
+    mat4 u_ProjectionView;
+    vec2 u_ViewportBottomLeft;
+    vec2 u_PixelsPerUnit;
+    float u_Time;
+};
 
 void main()
 {
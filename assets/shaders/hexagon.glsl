@@ -0,0 +1,51 @@
+#type vertex
+#version 330 core
+
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec2 a_InstancePosition;
+layout(location = 2) in vec2 a_InstanceSize;
+layout(location = 3) in vec4 a_InstanceColor;
+layout(location = 4) in float a_InstanceBorderRatio;
+
+out vec2 v_LocalPosition;
+out vec4 v_Color;
+flat out float v_BorderRatio;
+
+layout(std140) uniform FrameData
+{
+    mat4 u_ProjectionView;
+    vec2 u_ViewportBottomLeft;
+    vec2 u_PixelsPerUnit;
+    float u_Time;
+};
+
+void main()
+{
+    v_LocalPosition = a_Position.xy;
+    v_Color = a_InstanceColor;
+    v_BorderRatio = a_InstanceBorderRatio;
+
+    vec2 position = a_InstancePosition + a_Position.xy * a_InstanceSize;
+    gl_Position = u_ProjectionView * vec4(position, a_Position.z, 1.0f);
+}
+
+#type fragment
+#version 330 core
+
+in vec2 v_LocalPosition;
+in vec4 v_Color;
+flat in float v_BorderRatio;
+
+out vec4 OutputColor;
+
+void main()
+{
+    // 0.0 in the center of the hexagon, 1.0 on its outline
+    vec2 p = abs(v_LocalPosition);
+    float radius = max(p.y / 0.866025404, p.x + p.y * 0.577350269);
+
+    if (radius < v_BorderRatio)
+        discard;
+
+    OutputColor = v_Color;
+}
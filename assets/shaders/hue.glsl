@@ -2,24 +2,57 @@
 #version 330 core
 
 layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec2 a_InstancePosition;
+layout(location = 2) in vec2 a_InstanceSize;
+layout(location = 3) in vec4 a_InstanceColor;
 
-uniform mat4 u_Model;
-uniform mat4 u_ProjectionView;
+out vec2 v_EffectPosition;
+flat out vec4 v_TileState;
+
+layout(std140) uniform FrameData
+{
+    mat4 u_ProjectionView;
+    vec2 u_ViewportBottomLeft;
+    vec2 u_PixelsPerUnit;
+    float u_Time;
+};
+
+uniform sampler2D u_TileState;
 
 void main()
 {
-    gl_Position = u_ProjectionView * u_Model * vec4(a_Position, 1.0f);
+    // Instance color carries the coordinates of the tile in the tile state texture
+    v_TileState = texelFetch(u_TileState, ivec2(a_InstanceColor.xy), 0);
+
+    // Tiles without an owner collapse into a degenerate triangle and never reach the fragment shader
+    if ((int(v_TileState.a * 255.0 + 0.5) & 1) == 0)
+    {
+        gl_Position = vec4(0.0);
+        return;
+    }
+
+    // 0.0 in the middle of the tile, tile height spans 2.0
+    v_EffectPosition = a_Position.xy * a_InstanceSize * 2.0 / 1.7320508;
+
+    vec2 position = a_InstancePosition + a_Position.xy * a_InstanceSize;
+    gl_Position = u_ProjectionView * vec4(position, a_Position.z, 1.0f);
 }
 
 #type fragment
 #version 330 core
 
+in vec2 v_EffectPosition;
+flat in vec4 v_TileState;
+
 out vec4 OutputColor;
 
-uniform float u_Time;
-uniform vec2 u_BottomLeftPx;
-uniform vec2 u_SizePx;
-uniform vec3 u_Color;
+layout(std140) uniform FrameData
+{
+    mat4 u_ProjectionView;
+    vec2 u_ViewportBottomLeft;
+    vec2 u_PixelsPerUnit;
+    float u_Time;
+};
 
 float sdHexagon( in vec2 p, in float r )
 {
@@ -32,10 +65,11 @@ float sdHexagon( in vec2 p, in float r )
 
 void main()
 {
-    vec2 uv = ((gl_FragCoord.xy - u_BottomLeftPx) * 2.0f - u_SizePx * 0.5f) / u_SizePx.y;
-    float size = u_SizePx.x;
-    float r = 0.78 + (sin(u_Time * 4.0) + 1.0 / 2.0) * 0.02;
-    float d = sdHexagon(uv, r);
+    // Glow only pulses while the current player still has units to move on the tile
+    bool animated = (int(v_TileState.a * 255.0 + 0.5) & 2) != 0;
+    float time = animated ? u_Time : 1.3;
+    float r = 0.78 + (sin(time * 4.0) + 1.0 / 2.0) * 0.02;
+    float d = sdHexagon(v_EffectPosition, r);
     float blur = smoothstep(0.34, 0.2, d);
-    OutputColor = vec4(u_Color, blur);
+    OutputColor = vec4(v_TileState.rgb, blur);
 }
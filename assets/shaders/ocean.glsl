@@ -0,0 +1,54 @@
+#type vertex
+#version 330 core
+
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec2 a_InstancePosition;
+layout(location = 2) in vec2 a_InstanceSize;
+
+out vec2 v_WorldPosition;
+
+layout(std140) uniform FrameData
+{
+    mat4 u_ProjectionView;
+    vec2 u_ViewportBottomLeft;
+    vec2 u_PixelsPerUnit;
+    float u_Time;
+};
+
+void main()
+{
+    v_WorldPosition = a_InstancePosition + a_Position.xy * a_InstanceSize;
+    gl_Position = u_ProjectionView * vec4(v_WorldPosition, a_Position.z, 1.0f);
+}
+
+#type fragment
+#version 330 core
+
+in vec2 v_WorldPosition;
+
+out vec4 OutputColor;
+
+layout(std140) uniform FrameData
+{
+    mat4 u_ProjectionView;
+    vec2 u_ViewportBottomLeft;
+    vec2 u_PixelsPerUnit;
+    float u_Time;
+};
+
+void main()
+{
+    // Same pattern scale as water.glsl, but laid out in world space so it continues across neighbouring tiles
+    vec2 uv = v_WorldPosition * 2.0f / 1.7320508;
+
+    vec4 texture_color = vec4(0.192156862745098, 0.6627450980392157, 0.9333333333333333, 1.0);
+
+    vec4 k = vec4(u_Time)*0.8;
+    k.xy = uv * 2.0;
+    float val1 = length(0.5-fract(k.xyw*=mat3(vec3(-2.0,-1.0,0.0), vec3(3.0,-1.0,1.0), vec3(1.0,-1.0,-1.0))*0.5));
+    float val2 = length(0.5-fract(k.xyw*=mat3(vec3(-2.0,-1.0,0.0), vec3(3.0,-1.0,1.0), vec3(1.0,-1.0,-1.0))*0.2));
+    float val3 = length(0.5-fract(k.xyw*=mat3(vec3(-2.0,-1.0,0.0), vec3(3.0,-1.0,1.0), vec3(1.0,-1.0,-1.0))*0.5));
+    vec4 color = vec4(pow(min(min(val1, val2), val3), 7.0) * 3.0) + texture_color;
+
+    OutputColor = color;
+}
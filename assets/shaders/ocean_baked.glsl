@@ -0,0 +1,61 @@
+#type vertex
+#version 330 core
+
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec2 a_InstancePosition;
+layout(location = 2) in vec2 a_InstanceSize;
+
+out vec2 v_WorldPosition;
+
+layout(std140) uniform FrameData
+{
+    mat4 u_ProjectionView;
+    vec2 u_ViewportBottomLeft;
+    vec2 u_PixelsPerUnit;
+    float u_Time;
+};
+
+void main()
+{
+    v_WorldPosition = a_InstancePosition + a_Position.xy * a_InstanceSize;
+    gl_Position = u_ProjectionView * vec4(v_WorldPosition, a_Position.z, 1.0f);
+}
+
+#type fragment
+#version 330 core
+
+// must match the WATER_ANIMATION_* definitions in ocean.h
+#define FRAME_SIZE 128.0
+#define FRAME_COUNT 16.0
+#define PERIOD 10.0
+#define WORLD_SIZE 4.0
+
+in vec2 v_WorldPosition;
+
+out vec4 OutputColor;
+
+layout(std140) uniform FrameData
+{
+    mat4 u_ProjectionView;
+    vec2 u_ViewportBottomLeft;
+    vec2 u_PixelsPerUnit;
+    float u_Time;
+};
+
+uniform sampler2D u_Animation;
+
+vec4 SampleFrame(float frame, vec2 local)
+{
+    return texture(u_Animation, vec2((mod(frame, FRAME_COUNT) + local.x) / FRAME_COUNT, local.y));
+}
+
+void main()
+{
+    // Frames are mirrored when repeated, so neighbouring repetitions meet without seams
+    vec2 local = abs(fract(v_WorldPosition / WORLD_SIZE * 0.5) * 2.0 - 1.0);
+    // Keep filtering from reaching into the neighbouring frames of the strip
+    local.x = clamp(local.x, 0.5 / FRAME_SIZE, 1.0 - 0.5 / FRAME_SIZE);
+
+    float frame = fract(u_Time / PERIOD) * FRAME_COUNT;
+    OutputColor = mix(SampleFrame(floor(frame), local), SampleFrame(floor(frame) + 1.0, local), fract(frame));
+}
@@ -2,24 +2,59 @@
 #version 330 core
 
 layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec2 a_InstancePosition;
+layout(location = 2) in vec2 a_InstanceSize;
+layout(location = 3) in vec4 a_InstanceColor;
 
-uniform mat4 u_Model;
-uniform mat4 u_ProjectionView;
+out vec2 v_EffectPosition;
+flat out int v_PotionType;
+
+layout(std140) uniform FrameData
+{
+    mat4 u_ProjectionView;
+    vec2 u_ViewportBottomLeft;
+    vec2 u_PixelsPerUnit;
+    float u_Time;
+};
+
+uniform sampler2D u_TileState;
 
 void main()
 {
-    gl_Position = u_ProjectionView * u_Model * vec4(a_Position, 1.0f);
+    // Instance color carries the coordinates of the tile in the tile state texture,
+    // potion type is stored one based above the two flag bits, 0 when no potion is applied
+    vec4 tileState = texelFetch(u_TileState, ivec2(a_InstanceColor.xy), 0);
+    v_PotionType = (int(tileState.a * 255.0 + 0.5) >> 2) - 1;
+
+    if (v_PotionType < 0)
+    {
+        gl_Position = vec4(0.0);
+        return;
+    }
+
+    // 0.0 in the middle of the tile, tile height spans 2.0
+    v_EffectPosition = a_Position.xy * a_InstanceSize * 2.0 / 1.7320508;
+
+    vec2 position = a_InstancePosition + a_Position.xy * a_InstanceSize;
+    gl_Position = u_ProjectionView * vec4(position, a_Position.z, 1.0f);
 }
 
 #type fragment
 #version 330 core
 
+in vec2 v_EffectPosition;
+flat in int v_PotionType;
+
 out vec4 OutputColor;
 
-uniform float u_Time;
-uniform vec2 u_BottomLeftPx;
-uniform vec2 u_SizePx;
-uniform vec3 u_Color;
+// indexed by PotionType
+const vec3 c_PotionColors[5] = vec3[](
+    vec3(0.95, 0.3, 0.2),   // HEALING
+    vec3(0.25, 0.6, 0.95),  // IMMUNITY
+    vec3(0.25, 0.9, 0.2),   // REDUCE_DAMAGE
+    vec3(0.9, 0.9, 0.2),    // INCREASE_YIELD
+    vec3(0.1, 0.1, 0.1)     // DEAL_DAMAGE
+);
 
 float sdHexagon( in vec2 p, in float r )
 {
@@ -32,8 +67,7 @@ float sdHexagon( in vec2 p, in float r )
 
 void main()
 {
-    vec2 uv = ((gl_FragCoord.xy - u_BottomLeftPx) * 2.0f - u_SizePx * 0.5f) / u_SizePx.y;
-    float d = sdHexagon(uv, 1.0f);
+    float d = sdHexagon(v_EffectPosition, 1.0f);
     float alpha = max(0.0f, 0.4f - abs(d)) + 0.4f;
-    OutputColor = vec4(u_Color, alpha);
+    OutputColor = vec4(c_PotionColors[v_PotionType], alpha);
 }
@@ -0,0 +1,65 @@
+#type vertex
+#version 330 core
+
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec4 a_Color;
+layout(location = 2) in vec2 a_TexCoord;
+layout(location = 3) in float a_TexIndex;
+
+out vec4 v_Color;
+out vec2 v_TexCoord;
+flat out int v_TexIndex;
+
+layout(std140) uniform FrameData
+{
+    mat4 u_ProjectionView;
+    vec2 u_ViewportBottomLeft;
+    vec2 u_PixelsPerUnit;
+    float u_Time;
+};
+
+void main()
+{
+    v_Color = a_Color;
+    v_TexCoord = a_TexCoord;
+    v_TexIndex = int(a_TexIndex);
+    gl_Position = u_ProjectionView * vec4(a_Position, 1.0f);
+}
+
+#type fragment
+#version 330 core
+
+in vec4 v_Color;
+in vec2 v_TexCoord;
+flat in int v_TexIndex;
+out vec4 OutputColor;
+
+uniform sampler2D u_Textures[16];
+
+void main()
+{
+    // GLSL 3.30 only allows indexing sampler arrays with constant expressions
+    vec4 sampled;
+    switch (v_TexIndex)
+    {
+        case  0: sampled = texture(u_Textures[ 0], v_TexCoord); break;
+        case  1: sampled = texture(u_Textures[ 1], v_TexCoord); break;
+        case  2: sampled = texture(u_Textures[ 2], v_TexCoord); break;
+        case  3: sampled = texture(u_Textures[ 3], v_TexCoord); break;
+        case  4: sampled = texture(u_Textures[ 4], v_TexCoord); break;
+        case  5: sampled = texture(u_Textures[ 5], v_TexCoord); break;
+        case  6: sampled = texture(u_Textures[ 6], v_TexCoord); break;
+        case  7: sampled = texture(u_Textures[ 7], v_TexCoord); break;
+        case  8: sampled = texture(u_Textures[ 8], v_TexCoord); break;
+        case  9: sampled = texture(u_Textures[ 9], v_TexCoord); break;
+        case 10: sampled = texture(u_Textures[10], v_TexCoord); break;
+        case 11: sampled = texture(u_Textures[11], v_TexCoord); break;
+        case 12: sampled = texture(u_Textures[12], v_TexCoord); break;
+        case 13: sampled = texture(u_Textures[13], v_TexCoord); break;
+        case 14: sampled = texture(u_Textures[14], v_TexCoord); break;
+        case 15: sampled = texture(u_Textures[15], v_TexCoord); break;
+        default: sampled = vec4(1.0f, 0.0f, 1.0f, 1.0f); break;
+    }
+
+    OutputColor = sampled * v_Color;
+}
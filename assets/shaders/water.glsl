@@ -4,7 +4,14 @@
 layout(location = 0) in vec3 a_Position;
 
 uniform mat4 u_Model;
-uniform mat4 u_ProjectionView;
+
+layout(std140) uniform FrameData
+{
+    mat4 u_ProjectionView;
+    vec2 u_ViewportBottomLeft;
+    vec2 u_PixelsPerUnit;
+    float u_Time;
+};
 
 void main()
 {
@@ -16,13 +23,22 @@ void main()
 
 out vec4 OutputColor;
 
-uniform float u_Time;
-uniform vec2 u_BottomLeftPx;
-uniform vec2 u_SizePx;
+layout(std140) uniform FrameData
+{
+    mat4 u_ProjectionView;
+    vec2 u_ViewportBottomLeft;
+    vec2 u_PixelsPerUnit;
+    float u_Time;
+};
+
+uniform vec2 u_EffectPosition;
+uniform vec2 u_EffectSize;
 
 void main()
 {
-    vec2 uv = ((gl_FragCoord.xy - u_BottomLeftPx) * 2.0f - u_SizePx * 0.5f) / u_SizePx.y;
+    vec2 bottomLeftPx = (u_EffectPosition - u_ViewportBottomLeft) * u_PixelsPerUnit;
+    vec2 sizePx = u_EffectSize * u_PixelsPerUnit;
+    vec2 uv = ((gl_FragCoord.xy - bottomLeftPx) * 2.0f - sizePx * 0.5f) / sizePx.y;
 
     vec4 texture_color = vec4(0.192156862745098, 0.6627450980392157, 0.9333333333333333, 1.0);
 
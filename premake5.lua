@@ -56,6 +56,94 @@ project "UltimateWar"
     filter "system:windows"
         defines { "_WINDOWS" }
 
+-- Headless tool simulating battles to tune unit and building data, never opens a window
+project "BalanceSimulator"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++17"
+	architecture "x86_64"
+    warnings "Default"
+
+    targetdir "bin/%{cfg.buildcfg}-%{cfg.system}"
+    objdir "obj/%{cfg.buildcfg}-%{cfg.system}/BalanceSimulator"
+
+    includedirs {
+        "src/",
+        "tools/balance_simulator/",
+        "vendor/",
+        "vendor/glm/",
+        "vendor/imgui/",
+        "vendor/glad/include/",
+        "vendor/glfw/include/",
+        "vendor/imgui/backends",
+        "vendor/spdlog/include/",
+        "vendor/freetype/include/"
+    }
+
+    files {
+        "src/**.h",
+        "src/**.cpp",
+        "tools/balance_simulator/**.h",
+        "tools/balance_simulator/**.cpp"
+    }
+
+    removefiles { "src/main.cpp" }
+
+    links { "GLFW", "GLM", "GLAD", "ImGui", "stb", "spdlog", "FreeType" }
+
+    filter "configurations:Release"
+        optimize "Speed"
+
+    filter "system:linux"
+        toolset "clang"
+        links { "dl", "pthread" }
+        defines { "_X11" }
+
+    filter "system:windows"
+        defines { "_WINDOWS" }
+
+-- Headless check recording one frame of a started game and asserting its draw counts, never opens a window.
+-- Run it from the repository root, it loads the game assets.
+project "RenderCheck"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++17"
+	architecture "x86_64"
+    warnings "Default"
+
+    targetdir "bin/%{cfg.buildcfg}-%{cfg.system}"
+    objdir "obj/%{cfg.buildcfg}-%{cfg.system}/RenderCheck"
+
+    includedirs {
+        "src/",
+        "vendor/",
+        "vendor/glm/",
+        "vendor/imgui/",
+        "vendor/glad/include/",
+        "vendor/glfw/include/",
+        "vendor/imgui/backends",
+        "vendor/spdlog/include/",
+        "vendor/freetype/include/"
+    }
+
+    files {
+        "src/**.h",
+        "src/**.cpp",
+        "tools/render_check/**.cpp"
+    }
+
+    removefiles { "src/main.cpp" }
+
+    links { "GLFW", "GLM", "GLAD", "ImGui", "stb", "spdlog", "FreeType" }
+
+    filter "system:linux"
+        toolset "clang"
+        links { "dl", "pthread" }
+        defines { "_X11" }
+
+    filter "system:windows"
+        defines { "_WINDOWS" }
+
 group "Dependencies"
     include "vendor/glfw.lua"
     include "vendor/glad.lua"
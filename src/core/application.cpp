@@ -2,32 +2,37 @@
 
 #include "core/resource_manager.h"
 #include "graphics/renderer.h"
+#include "graphics/render_state.h"
 #include "loader/save_loader.h"
 #include "loader/save_loader_exception.h"
 #include "widgets/notification.h"
 
 Application* Application::s_Instance = nullptr;
 
-Application::Application()
+Application::Application(const WindowProps& windowProps)
 {
     s_Instance = this;
 
     Logger::Init();
-    m_Window = std::make_unique<Window>();
+    m_Window = std::make_unique<Window>(windowProps);
     m_Window->SetEventCallback(BIND_EVENT_FN(Application::OnEvent));
     m_LayerStack = std::make_unique<LayerStack>();
 
     LoadResources();
     InitializeColors();
 
-    Renderer2D::Init();
+    if (m_Window->IsHeadless())
+        Renderer2D::Init(std::make_shared<NullRenderBackend>());
+    else
+        Renderer2D::Init();
 
     m_MainMenuLayer = std::make_shared<MainMenuLayer>();
     m_MainMenuLayer->OnAttach();
     m_LayerStack->PushLayer(m_MainMenuLayer);
 
 #if defined(DEBUG)
-    DebugLayer::InitImGui();
+    if (!m_Window->IsHeadless())
+        DebugLayer::InitImGui();
 #endif
 }
 
@@ -36,7 +41,8 @@ Application::~Application()
     Renderer2D::Shutdown();
 
 #if defined(DEBUG)
-    DebugLayer::ShutdownImGui();
+    if (!m_Window->IsHeadless())
+        DebugLayer::ShutdownImGui();
 #endif
 }
 
@@ -64,26 +70,31 @@ bool Application::OnWindowClose(WindowClosedEvent& event)
 
 void Application::Run()
 {
-    static float lastTime = 0.0f;
     while (m_Running)
-    {
-        float now = (float)glfwGetTime();
-        m_DeltaTime = now - lastTime;
-        lastTime = now;
+        RunFrame((float)glfwGetTime());
+}
 
-        for (auto layer : *m_LayerStack)
-        {
-            if (!layer->IsActive())
-                continue;
+void Application::RunFrame(float time)
+{
+    m_DeltaTime = time - m_Time;
+    m_Time = time;
 
-            layer->OnUpdate(m_DeltaTime);
-        }
+    Renderer2D::SetTime(time);
+    Renderer2D::ResetStats();
+    RenderState::ResetStats();
 
-        if (m_LayerStackReload != LayerStackReload::NONE)
-            ProcessLayerStackReload();
+    for (auto layer : *m_LayerStack)
+    {
+        if (!layer->IsActive())
+            continue;
 
-        m_Window->OnUpdate();
+        layer->OnUpdate(m_DeltaTime);
     }
+
+    if (m_LayerStackReload != LayerStackReload::NONE)
+        ProcessLayerStackReload();
+
+    m_Window->OnUpdate();
 }
 
 void Application::OpenMainMenu()
@@ -133,49 +144,54 @@ void Application::LoadResources()
     ResourceManager::LoadFont("vinque", "assets/fonts/vinque/vinque.otf");
     ResourceManager::LoadFont("rexlia", "assets/fonts/rexlia/rexlia.otf");
 
-    ResourceManager::LoadShader("font", "assets/shaders/font.glsl");
     ResourceManager::LoadShader("color", "assets/shaders/color.glsl");
-    ResourceManager::LoadShader("texture", "assets/shaders/texture.glsl");
+    ResourceManager::LoadShader("quad", "assets/shaders/quad.glsl");
+    ResourceManager::LoadShader("hexagon", "assets/shaders/hexagon.glsl");
     ResourceManager::LoadShader("water", "assets/shaders/water.glsl");
+    ResourceManager::LoadShader("ocean", "assets/shaders/ocean.glsl");
+    ResourceManager::LoadShader("ocean_baked", "assets/shaders/ocean_baked.glsl");
     ResourceManager::LoadShader("hue", "assets/shaders/hue.glsl");
     ResourceManager::LoadShader("potion", "assets/shaders/potion.glsl");
 
-    ResourceManager::LoadTexture("swordsman", "assets/textures/units/swordsman.png");
-    ResourceManager::LoadTexture("archer", "assets/textures/units/archer.png");
-    ResourceManager::LoadTexture("dwarf", "assets/textures/units/dwarf.png");
-    ResourceManager::LoadTexture("demon", "assets/textures/units/demon.png");
-    ResourceManager::LoadTexture("harpy", "assets/textures/units/harpy.png");
-
-    ResourceManager::LoadTexture("sand", "assets/textures/envs/sand.png");
-    ResourceManager::LoadTexture("stone", "assets/textures/envs/stone.png");
-    ResourceManager::LoadTexture("tree", "assets/textures/envs/tree.png");
-
-    ResourceManager::LoadTexture("wood", "assets/textures/resources/wood.png");
-    ResourceManager::LoadTexture("rock", "assets/textures/resources/rock.png");
-    ResourceManager::LoadTexture("steel", "assets/textures/resources/steel.png");
-    ResourceManager::LoadTexture("gold", "assets/textures/resources/gold.png");
-
-    ResourceManager::LoadTexture("cross", "assets/textures/icons/cross.png");
-    ResourceManager::LoadTexture("up_arrow", "assets/textures/icons/up_arrow.png");
-    ResourceManager::LoadTexture("chest_open", "assets/textures/icons/chest_open.png");
-    ResourceManager::LoadTexture("chest_closed", "assets/textures/icons/chest_closed.png");
-    ResourceManager::LoadTexture("confetti", "assets/textures/icons/confetti.png");
-
-    ResourceManager::LoadTexture("healing", "assets/textures/potions/healing.png");
-    ResourceManager::LoadTexture("immunity", "assets/textures/potions/immunity.png");
-    ResourceManager::LoadTexture("reduce_damage", "assets/textures/potions/reduce_damage.png");
-    ResourceManager::LoadTexture("deal_damage", "assets/textures/potions/deal_damage.png");
-    ResourceManager::LoadTexture("increase_yield", "assets/textures/potions/increase_yield.png");
-
-    ResourceManager::LoadTexture("target", "assets/textures/buildings/target.png");
-    ResourceManager::LoadTexture("blacksmith", "assets/textures/buildings/blacksmith.png");
-    ResourceManager::LoadTexture("gold_mine", "assets/textures/buildings/gold_mine.png");
-    ResourceManager::LoadTexture("harpy_tower", "assets/textures/buildings/harpy_tower.png");
-    ResourceManager::LoadTexture("demon_castle", "assets/textures/buildings/demon_castle.png");
-
-    ResourceManager::LoadTexture("shield", "assets/textures/stats/shield.png");
-    ResourceManager::LoadTexture("swords", "assets/textures/stats/swords.png");
-    ResourceManager::LoadTexture("heart", "assets/textures/stats/heart.png");
+    // Sprites are packed into one atlas, so icons drawn next to each other do not switch textures
+    ResourceManager::LoadAtlasTexture("swordsman", "assets/textures/units/swordsman.png");
+    ResourceManager::LoadAtlasTexture("archer", "assets/textures/units/archer.png");
+    ResourceManager::LoadAtlasTexture("dwarf", "assets/textures/units/dwarf.png");
+    ResourceManager::LoadAtlasTexture("demon", "assets/textures/units/demon.png");
+    ResourceManager::LoadAtlasTexture("harpy", "assets/textures/units/harpy.png");
+
+    ResourceManager::LoadAtlasTexture("sand", "assets/textures/envs/sand.png");
+    ResourceManager::LoadAtlasTexture("stone", "assets/textures/envs/stone.png");
+    ResourceManager::LoadAtlasTexture("tree", "assets/textures/envs/tree.png");
+
+    ResourceManager::LoadAtlasTexture("wood", "assets/textures/resources/wood.png");
+    ResourceManager::LoadAtlasTexture("rock", "assets/textures/resources/rock.png");
+    ResourceManager::LoadAtlasTexture("steel", "assets/textures/resources/steel.png");
+    ResourceManager::LoadAtlasTexture("gold", "assets/textures/resources/gold.png");
+
+    ResourceManager::LoadAtlasTexture("cross", "assets/textures/icons/cross.png");
+    ResourceManager::LoadAtlasTexture("up_arrow", "assets/textures/icons/up_arrow.png");
+    ResourceManager::LoadAtlasTexture("chest_open", "assets/textures/icons/chest_open.png");
+    ResourceManager::LoadAtlasTexture("chest_closed", "assets/textures/icons/chest_closed.png");
+    ResourceManager::LoadAtlasTexture("confetti", "assets/textures/icons/confetti.png");
+
+    ResourceManager::LoadAtlasTexture("healing", "assets/textures/potions/healing.png");
+    ResourceManager::LoadAtlasTexture("immunity", "assets/textures/potions/immunity.png");
+    ResourceManager::LoadAtlasTexture("reduce_damage", "assets/textures/potions/reduce_damage.png");
+    ResourceManager::LoadAtlasTexture("deal_damage", "assets/textures/potions/deal_damage.png");
+    ResourceManager::LoadAtlasTexture("increase_yield", "assets/textures/potions/increase_yield.png");
+
+    ResourceManager::LoadAtlasTexture("target", "assets/textures/buildings/target.png");
+    ResourceManager::LoadAtlasTexture("blacksmith", "assets/textures/buildings/blacksmith.png");
+    ResourceManager::LoadAtlasTexture("gold_mine", "assets/textures/buildings/gold_mine.png");
+    ResourceManager::LoadAtlasTexture("harpy_tower", "assets/textures/buildings/harpy_tower.png");
+    ResourceManager::LoadAtlasTexture("demon_castle", "assets/textures/buildings/demon_castle.png");
+
+    ResourceManager::LoadAtlasTexture("shield", "assets/textures/stats/shield.png");
+    ResourceManager::LoadAtlasTexture("swords", "assets/textures/stats/swords.png");
+    ResourceManager::LoadAtlasTexture("heart", "assets/textures/stats/heart.png");
+
+    ResourceManager::BuildTextureAtlas();
 }
 
 void Application::InitializeColors()
@@ -233,9 +249,12 @@ void Application::ProcessLayerStackReload()
             m_LayerStack->PushOverlay(m_UILayer);
 
 #if defined(DEBUG)
-            m_DebugLayer = std::make_shared<DebugLayer>();
-            m_DebugLayer->OnAttach();
-            m_LayerStack->PushOverlay(m_DebugLayer);
+            if (!m_Window->IsHeadless())
+            {
+                m_DebugLayer = std::make_shared<DebugLayer>();
+                m_DebugLayer->OnAttach();
+                m_LayerStack->PushOverlay(m_DebugLayer);
+            }
 #endif
 
             m_LastGameLayer = m_GameLayer;
@@ -252,7 +271,8 @@ void Application::ProcessLayerStackReload()
             m_UILayer->SetIsActive(true);
             m_UILayer->OnAttach();
 #if defined(DEBUG)
-            m_DebugLayer->SetIsActive(true);
+            if (m_DebugLayer)
+                m_DebugLayer->SetIsActive(true);
 #endif
             break;
         }
@@ -282,9 +302,12 @@ void Application::ProcessLayerStackReload()
             m_LayerStack->PushOverlay(m_UILayer);
 
 #if defined(DEBUG)
-            m_DebugLayer = std::make_shared<DebugLayer>();
-            m_DebugLayer->OnAttach();
-            m_LayerStack->PushOverlay(m_DebugLayer);
+            if (!m_Window->IsHeadless())
+            {
+                m_DebugLayer = std::make_shared<DebugLayer>();
+                m_DebugLayer->OnAttach();
+                m_LayerStack->PushOverlay(m_DebugLayer);
+            }
 #endif
 
             m_LastGameLayer = m_GameLayer;
@@ -27,11 +27,14 @@ enum class LayerStackReload
 class Application
 {
 public:
-    Application();
+    // Headless window props give an application without a window, it draws through NullRenderBackend
+    Application(const WindowProps& windowProps = WindowProps());
     ~Application();
 
     void OnEvent(Event& event);
     void Run();
+    // Updates every layer once, time is given in seconds since the start
+    void RunFrame(float time);
 
     void OpenMainMenu();
     void OpenMapEditor();
@@ -42,6 +45,8 @@ public:
     void Exit() { m_Running = false; }
 
     bool LastGameAvailable() { return m_LastGameLayer ? true : false; }
+    // time of the frame being run, in seconds
+    float GetTime() const { return m_Time; }
 
     Window* GetWindow() { return m_Window.get(); }
     static Application& Get() { return *s_Instance; }
@@ -70,5 +75,6 @@ private:
     LayerStackReload m_LayerStackReload = LayerStackReload::NONE;
     NewGameDTO m_NewGameData;
     std::string m_SaveName;
-    float m_DeltaTime;
+    float m_DeltaTime = 0.0f;
+    float m_Time = 0.0f;
 };
@@ -4,12 +4,16 @@
 
 #include "application.h"
 
+// Without a native window (headless runs) nothing is pressed and the cursor stays in the corner
 class Input
 {
 public:
     static bool IsKeyPressed(int key)
     {
         auto window = Application::Get().GetWindow()->GetNativeWindow();
+        if (!window)
+            return false;
+
         int state = glfwGetKey(window, key);
         return state == GLFW_PRESS || state == GLFW_REPEAT;
     }
@@ -17,6 +21,9 @@ public:
     static bool IsMouseButtonPressed(int button)
     {
         auto window = Application::Get().GetWindow()->GetNativeWindow();
+        if (!window)
+            return false;
+
         int state = glfwGetMouseButton(window, button);
         return state == GLFW_PRESS;
     }
@@ -24,6 +31,9 @@ public:
     static glm::vec2 GetMousePosition()
     {
         auto window = Application::Get().GetWindow()->GetNativeWindow();
+        if (!window)
+            return { 0.0f, 0.0f };
+
         double xpos, ypos;
         glfwGetCursorPos(window, &xpos, &ypos);
         return { xpos, ypos };
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <new>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+#include "core/logger.h"
+
+// number of objects allocated at once when a pool runs out of free slots
+#define OBJECT_POOL_CHUNK_SIZE 256
+
+#define INVALID_POOL_INDEX 0xFFFFFFFF
+
+// Refers to a pooled object without owning it. Slots are reused, so each one counts its generation
+// and a handle to a destroyed object stays invalid even after another object takes its slot.
+struct PoolHandle
+{
+    uint32_t Index = INVALID_POOL_INDEX;
+    uint32_t Generation = 0;
+};
+
+// Allocates objects in chunks and reuses the slots of destroyed ones, so creating and destroying
+// objects does no heap allocation once the pool has grown. Objects never move once created.
+template<typename T>
+class ObjectPool
+{
+public:
+    ObjectPool(const char* name)
+        : m_Name(name), m_SlotCount(0), m_AliveCount(0)
+    {
+    }
+
+    ~ObjectPool()
+    {
+        for (uint32_t i = 0; i < m_SlotCount; i++)
+        {
+            Slot& slot = GetSlot(i);
+            if (slot.Alive)
+                reinterpret_cast<T*>(slot.Storage)->~T();
+        }
+    }
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    template<typename... Args>
+    T* Create(Args&&... args)
+    {
+        uint32_t index;
+        if (!m_FreeSlots.empty())
+        {
+            index = m_FreeSlots.back();
+            m_FreeSlots.pop_back();
+        }
+        else
+        {
+            if (m_SlotCount % OBJECT_POOL_CHUNK_SIZE == 0)
+                m_Chunks.emplace_back(new Slot[OBJECT_POOL_CHUNK_SIZE]);
+            index = m_SlotCount++;
+        }
+
+        Slot& slot = GetSlot(index);
+        T* object = new (slot.Storage) T(std::forward<Args>(args)...);
+        slot.Index = index;
+        slot.Alive = true;
+        m_AliveCount++;
+        return object;
+    }
+
+    // Object has to come from this pool, nullptr is ignored
+    void Destroy(T* object)
+    {
+        if (!object)
+            return;
+
+        Slot* slot = ToSlot(object);
+        if (!slot->Alive)
+        {
+            LOG_WARN("ObjectPool::Destroy: {0} object destroyed twice", m_Name);
+            return;
+        }
+
+        object->~T();
+        slot->Alive = false;
+        slot->Generation++;
+        m_FreeSlots.push_back(slot->Index);
+        m_AliveCount--;
+    }
+
+    PoolHandle GetHandle(const T* object) const
+    {
+        if (!object)
+            return PoolHandle();
+
+        const Slot* slot = ToSlot(object);
+        return { slot->Index, slot->Generation };
+    }
+
+    // nullptr when the object of the handle was already destroyed
+    T* Get(PoolHandle handle)
+    {
+        if (handle.Index >= m_SlotCount)
+            return nullptr;
+
+        Slot& slot = GetSlot(handle.Index);
+        if (!slot.Alive || slot.Generation != handle.Generation)
+            return nullptr;
+
+        return reinterpret_cast<T*>(slot.Storage);
+    }
+
+    inline bool IsValid(PoolHandle handle) { return Get(handle) != nullptr; }
+
+    inline const char* GetName() const { return m_Name; }
+    inline uint32_t GetAliveCount() const { return m_AliveCount; }
+    inline uint32_t GetCapacity() const { return m_Chunks.size() * OBJECT_POOL_CHUNK_SIZE; }
+
+    // Meant to be called once everything holding pooled objects is gone
+    void ReportLeaks() const
+    {
+        if (m_AliveCount > 0)
+            LOG_WARN("ObjectPool: {0} {1} object(s) were never destroyed", m_AliveCount, m_Name);
+        else
+            LOG_INFO("ObjectPool: no {0} objects leaked, {1} slots were allocated", m_Name, m_SlotCount);
+    }
+
+private:
+    // Storage comes first, so a pointer to the object is also a pointer to its slot
+    struct Slot
+    {
+        alignas(T) unsigned char Storage[sizeof(T)];
+        uint32_t Index = INVALID_POOL_INDEX;
+        uint32_t Generation = 0;
+        bool Alive = false;
+    };
+
+    inline Slot& GetSlot(uint32_t index) { return m_Chunks[index / OBJECT_POOL_CHUNK_SIZE][index % OBJECT_POOL_CHUNK_SIZE]; }
+    inline static Slot* ToSlot(T* object) { return reinterpret_cast<Slot*>(object); }
+    inline static const Slot* ToSlot(const T* object) { return reinterpret_cast<const Slot*>(object); }
+
+private:
+    const char* m_Name;
+    std::vector<std::unique_ptr<Slot[]>> m_Chunks;
+    std::vector<uint32_t> m_FreeSlots;
+    uint32_t m_SlotCount;
+    uint32_t m_AliveCount;
+};
@@ -9,6 +9,7 @@
 std::unordered_map<std::string, std::shared_ptr<Font>> ResourceManager::m_FontCache;
 std::unordered_map<std::string, std::shared_ptr<Shader>> ResourceManager::m_ShaderCache;
 std::unordered_map<std::string, std::shared_ptr<Texture2D>> ResourceManager::m_TextureCache;
+TextureAtlasBuilder ResourceManager::m_AtlasBuilder;
 
 void ResourceManager::LoadFont(const std::string& name, const std::string& filepath)
 {
@@ -62,6 +63,33 @@ void ResourceManager::LoadTexture(const std::string& name, const std::string& fi
     m_TextureCache[name] = texture;
 }
 
+void ResourceManager::LoadAtlasTexture(const std::string& name, const std::string& filepath)
+{
+    if (m_TextureCache.find(name) != m_TextureCache.end())
+    {
+        LOG_ERROR("ResourceManager: Texture with name {0} already in cache", name);
+        return;
+    }
+
+    int width, height, nrChannels;
+    stbi_set_flip_vertically_on_load(1);
+    unsigned char *data = stbi_load(filepath.c_str(), &width, &height, &nrChannels, 4);
+    if (!data)
+    {
+        LOG_ERROR("ResourceManager: Could not open texture file {0}", filepath);
+        return;
+    }
+
+    m_AtlasBuilder.Add(name, { width, height }, data);
+    stbi_image_free(data);
+}
+
+void ResourceManager::BuildTextureAtlas()
+{
+    for (auto& region : m_AtlasBuilder.Build())
+        m_TextureCache[region.first] = region.second;
+}
+
 const std::shared_ptr<Font>& ResourceManager::GetFont(const std::string& name)
 {
     if (m_FontCache.find(name) == m_FontCache.end())
@@ -8,6 +8,7 @@
 #include "graphics/font.h"
 #include "graphics/shader.h"
 #include "graphics/texture.h"
+#include "graphics/texture_atlas.h"
 
 class ResourceManager
 {
@@ -15,6 +16,9 @@ public:
     static void LoadFont(const std::string& name, const std::string& filepath);
     static void LoadShader(const std::string& name, const std::string& filepath);
     static void LoadTexture(const std::string& name, const std::string& filepath);
+    // Queues a sprite to be packed into a shared atlas, it is available through GetTexture once BuildTextureAtlas is called
+    static void LoadAtlasTexture(const std::string& name, const std::string& filepath);
+    static void BuildTextureAtlas();
 
     static const std::shared_ptr<Font>& GetFont(const std::string& name);
     static const std::shared_ptr<Shader>& GetShader(const std::string& name);
@@ -26,4 +30,5 @@ private:
     static std::unordered_map<std::string, std::shared_ptr<Font>> m_FontCache;
     static std::unordered_map<std::string, std::shared_ptr<Shader>> m_ShaderCache;
     static std::unordered_map<std::string, std::shared_ptr<Texture2D>> m_TextureCache;
+    static TextureAtlasBuilder m_AtlasBuilder;
 };
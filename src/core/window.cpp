@@ -3,8 +3,15 @@
 #include "core/logger.h"
 
 Window::Window(const WindowProps& props)
-    : m_WindowData({props.Title, props.Width, props.Height, true})
+    : m_Window(nullptr), m_GraphicsContext(nullptr), m_Headless(props.Headless),
+      m_WindowData({props.Title, props.Width, props.Height, true})
 {
+    if (m_Headless)
+    {
+        LOG_INFO("Running without a window");
+        return;
+    }
+
     Init();
 }
 
@@ -152,11 +159,17 @@ void Window::Init()
 
 void Window::Shutdown()
 {
+    if (!m_Window)
+        return;
+
     glfwDestroyWindow(m_Window);
 }
 
 void Window::OnUpdate()
 {
+    if (!m_Window)
+        return;
+
     glfwPollEvents();
     m_GraphicsContext->SwapBuffers();
 }
@@ -168,7 +181,8 @@ bool Window::IsVSyncEnabled() const
 
 void Window::SetVSync(bool enabled)
 {
-    glfwSwapInterval(enabled ? 1 : 0);
+    if (m_Window)
+        glfwSwapInterval(enabled ? 1 : 0);
     m_WindowData.VSyncEnabled = enabled;
 }
 
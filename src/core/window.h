@@ -14,11 +14,14 @@ struct WindowProps
 {
     std::string Title;
     unsigned int Width, Height;
+    // no window and no graphics context are created, only the size is kept
+    bool Headless;
 
     WindowProps(const std::string& title = "Application",
                 unsigned int width = 1920,
-                unsigned int height = 1080)
-        : Title(title), Width(width), Height(height)
+                unsigned int height = 1080,
+                bool headless = false)
+        : Title(title), Width(width), Height(height), Headless(headless)
     {
     }
 };
@@ -35,6 +38,7 @@ public:
 
     inline unsigned int GetWidth() const { return m_WindowData.Width; }
     inline unsigned int GetHeight() const { return m_WindowData.Height; }
+    inline bool IsHeadless() const { return m_Headless; }
 
     bool IsVSyncEnabled() const;
     void SetVSync(bool enabled);
@@ -45,6 +49,7 @@ public:
 private:
     GLFWwindow* m_Window;
     GraphicsContext* m_GraphicsContext;
+    bool m_Headless;
 
     struct WindowData
     {
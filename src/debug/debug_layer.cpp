@@ -11,6 +11,7 @@
 #include "debug/debug_data.h"
 #include "core/application.h"
 #include "core/resource_manager.h"
+#include "graphics/render_state.h"
 
 DebugLayer::DebugLayer()
     : Layer("DebugLayer"), m_GameLayer(GameLayer::Get())
@@ -79,6 +80,19 @@ void DebugLayer::DisplayInfoWindow(float dt)
 
     ImGui::Separator();
 
+    const auto& stats = Renderer2D::GetStats();
+    ImGui::Text("Renderer");
+    ImGui::Text("  draw calls: %u", stats.DrawCalls);
+    ImGui::Text("  batched quads: %u", stats.QuadCount);
+    ImGui::Text("  hexagon instances: %u", stats.HexagonInstanceCount);
+
+    const auto& stateStats = RenderState::GetStats();
+    ImGui::Text("  state changes issued: %u", stateStats.Issued);
+    ImGui::Text("  state changes skipped: %u", stateStats.Skipped);
+    ImGui::Text("  program changes: %u", stateStats.ProgramChanges);
+
+    ImGui::Separator();
+
     auto camera = m_GameLayer.m_CameraController->GetCamera();
     auto pos = camera->GetPosition();
     ImGui::Text("Camera");
@@ -93,6 +107,13 @@ void DebugLayer::DisplayInfoWindow(float dt)
     ImGui::Text("  height: %dpx", window->GetHeight());
     ImGui::Text("  vsync: %s", window->IsVSyncEnabled() ? "enabled" : "disabled");
 
+    ImGui::Separator();
+
+    ImGui::Text("Object pools (alive / capacity)");
+    ImGui::Text("  unit stats: %u / %u", UnitStatsPool.GetAliveCount(), UnitStatsPool.GetCapacity());
+    ImGui::Text("  unit groups: %u / %u", UnitGroupPool.GetAliveCount(), UnitGroupPool.GetCapacity());
+    ImGui::Text("  buildings: %u / %u", BuildingPool.GetAliveCount(), BuildingPool.GetCapacity());
+
     ImGui::End();
 }
 
@@ -143,14 +164,18 @@ void DebugLayer::DisplaySettingsWindow()
     ImGui::Separator();
 
     ImGui::Text("UnitGroup settings");
-    ImGui::SliderInt("UnitGroup rows", &Tile::s_UnitGroupRows, 1, 3);
-    ImGui::SliderInt("UnitGroups per row", &Tile::s_UnitGroupsPerRow, 3, 7);
-    ImGui::SliderInt("UnitGroup width/offset ratio", &Tile::s_UnitGroupWidthToOffsetRatio, 1, 19);
+    if (ImGui::SliderInt("UnitGroup rows", &Tile::s_UnitGroupRows, 1, 3))
+        Tile::s_LayoutVersion++;
+    if (ImGui::SliderInt("UnitGroups per row", &Tile::s_UnitGroupsPerRow, 3, 7))
+        Tile::s_LayoutVersion++;
+    if (ImGui::SliderInt("UnitGroup width/offset ratio", &Tile::s_UnitGroupWidthToOffsetRatio, 1, 19))
+        Tile::s_LayoutVersion++;
 
     ImGui::Separator();
 
     ImGui::Text("Tile settings");
-    ImGui::SliderFloat("Height ratio", &Tile::s_BackgroundHeightRatio, 0.1f, 1.0f);
+    if (ImGui::SliderFloat("Height ratio", &Tile::s_BackgroundHeightRatio, 0.1f, 1.0f))
+        Tile::s_LayoutVersion++;
 
     ImGui::Separator();
 
@@ -61,7 +61,7 @@ void EditorLayer::OnUpdate(float dt)
     Renderer2D::BeginScene(m_CameraController->GetCamera());
 
     for (const auto& pair : m_Map) {
-        pair.second->DrawEnvironment(m_CameraController->GetCamera());
+        pair.second->DrawEnvironment();
     }
 
     Renderer2D::EndScene();
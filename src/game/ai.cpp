@@ -4,23 +4,22 @@
 #include <vector>
 
 #include "game/tile.h"
+#include "game/battle.h"
 #include "game/game_layer.h"
 #include "widgets/notification.h"
 
-const int MAX_INT = std::numeric_limits<int>::max();
-
 AI *AI::s_Instance = nullptr;
 
 AI::AI() { s_Instance = this; }
 
 void AI::MakeMove(const std::shared_ptr<Player> &player)
 {
-    auto gameLayer = GameLayer::Get();
+    auto& gameLayer = GameLayer::Get();
 
     auto tiles = player->GetOwnedTiles();
     auto map = gameLayer.GetGameMapManager();
 
-    std::vector<std::shared_ptr<Tile>> tilesToPlaceUnitGroupsOn{};
+    std::vector<Tile*> tilesToPlaceUnitGroupsOn{};
     for (auto tile : tiles)
     {
         auto coords = tile->GetCoords();
@@ -29,8 +28,8 @@ void AI::MakeMove(const std::shared_ptr<Player> &player)
             offset = -1;
 
         bool hasNeighboringOpponent = false;
-        std::shared_ptr<Tile> targetTile;
-        UnitStats minUnitStats = { MAX_INT, MAX_INT, MAX_INT };
+        Tile* targetTile = nullptr;
+        int maxRemainingHealth = 0;
         for (auto tileOffset : Tile::s_AdjacentTileOffsets)
         {
             glm::ivec2 location;
@@ -44,13 +43,17 @@ void AI::MakeMove(const std::shared_ptr<Player> &player)
             }
 
             auto adjTile = map->GetGameMap()->GetTile(location.x, location.y);
-            if (adjTile->AssetsCanExist() && adjTile->GetOwnedBy() != player)
+            if (adjTile->AssetsCanExist() && adjTile->GetOwnedBy() != player.get())
             {
-                UnitStats stats = adjTile->GetTotalUnitStats();
-                if (minUnitStats > stats)
+                hasNeighboringOpponent = true;
+                if (adjTile->GetPotion().IsApplied() && adjTile->GetPotion().GetType() == PotionType::IMMUNITY)
+                    continue;
+
+                // Attack the tile that is won while keeping the most health
+                BattlePrediction prediction = Battle::Predict(tile, adjTile, false);
+                if (prediction.Outcome == BattleOutcome::ATTACKER_WON && prediction.AttackerHealth > maxRemainingHealth)
                 {
-                    hasNeighboringOpponent = true;
-                    minUnitStats = stats;
+                    maxRemainingHealth = prediction.AttackerHealth;
                     targetTile = adjTile;
                 }
             }
@@ -58,7 +61,7 @@ void AI::MakeMove(const std::shared_ptr<Player> &player)
 
         if (hasNeighboringOpponent)
         {
-            if (tile->GetTotalUnitStats() > minUnitStats)
+            if (targetTile)
             {
                 tile->SelectAllUnitGroups();
                 tile->MoveToTile(targetTile);
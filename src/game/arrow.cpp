@@ -6,7 +6,7 @@
 #include "graphics/renderer.h"
 
 Arrow::Arrow(const glm::vec4& color, float thickness, float tipLength)
-    : m_Color(color), m_StartPosition({0.0f, 0.0f}), m_EndPosition({0.0f, 0.0f}),
+    : m_StartTile(nullptr), m_Color(color), m_StartPosition({0.0f, 0.0f}), m_EndPosition({0.0f, 0.0f}),
       m_Thickness(thickness), m_TipLength(tipLength), m_Visible(false), m_Activated(false)
 {
     float arrowVertices[7 * 2] = {
@@ -15,13 +15,13 @@ public:
 
     void Draw();
 
-    void SetStartTile(const std::shared_ptr<Tile>& tile) { m_StartTile = tile; m_StartPosition = tile->GetPosition(); }
+    void SetStartTile(Tile* tile) { m_StartTile = tile; m_StartPosition = tile->GetPosition(); }
     void SetEndPosition(const glm::vec2& endPosition) { m_EndPosition = endPosition; }
     void SetVisible(bool visible) { m_Visible = visible; }
     void SetActivated(bool activated) { m_Activated = activated; }
     void SetColor(const glm::vec4& color) { m_Color = color; }
 
-    const std::shared_ptr<Tile>& GetStartTile() { return m_StartTile; }
+    Tile* GetStartTile() { return m_StartTile; }
 
     inline const bool IsVisible() const { return m_Visible; }
     inline const bool IsActivated() const { return m_Activated; }
@@ -31,7 +31,7 @@ private:
 
 private:
     std::shared_ptr<VertexArray> m_ArrowVA;
-    std::shared_ptr<Tile> m_StartTile;
+    Tile* m_StartTile;
     glm::vec2 m_StartPosition;
     glm::vec2 m_EndPosition;
     glm::vec4 m_Color;
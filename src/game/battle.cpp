@@ -1,134 +1,252 @@
 #include "battle.h"
 
 #include <vector>
-#include <numeric>
 
 #include <glm/glm.hpp>
 
-#include "util/util.h"
-#include "core/logger.h"
+std::unordered_map<uint64_t, Battle::PredictionCacheEntry> Battle::s_PredictionCache;
 
-BattleOutcome Battle::CalculateBattleOutcome(const std::shared_ptr<Tile>& attacker, const std::shared_ptr<Tile>& defender)
+void BattleArmy::Clear()
 {
-    while (GetTotalUnitGroupHealth(attacker, true) > 0 && GetTotalUnitGroupHealth(defender, false) > 0)
+    Attack.clear();
+    Defense.clear();
+    Health.clear();
+    Source.clear();
+}
+
+void BattleArmy::Add(const UnitStats& stats, UnitStats* source)
+{
+    Attack.push_back(stats.Attack);
+    Defense.push_back(stats.Defense);
+    Health.push_back(stats.Health);
+    Source.push_back(source);
+}
+
+int BattleArmy::GetTotalHealth() const
+{
+    int totalHealth = 0;
+    for (size_t i = 0; i < Health.size(); i++)
+        totalHealth += Health[i];
+
+    return totalHealth;
+}
+
+void BattleArmy::RemoveDeadUnits()
+{
+    size_t alive = 0;
+    for (size_t i = 0; i < Health.size(); i++)
     {
-        SimulateBattleTick(attacker, defender);
-        CleanupBattleField(attacker, defender);
+        if (Health[i] <= 0)
+        {
+            if (Source[i])
+                Source[i]->Health = Health[i];
+            continue;
+        }
+
+        Attack[alive] = Attack[i];
+        Defense[alive] = Defense[i];
+        Health[alive] = Health[i];
+        Source[alive] = Source[i];
+        alive++;
     }
 
-    return GetTotalUnitGroupHealth(attacker, true) > 0 ? BattleOutcome::ATTACKER_WON : BattleOutcome::DEFENDER_WON;
+    Attack.resize(alive);
+    Defense.resize(alive);
+    Health.resize(alive);
+    Source.resize(alive);
 }
 
-void Battle::SimulateBattleTick(const std::shared_ptr<Tile>& attacker, const std::shared_ptr<Tile>& defender)
+void BattleArmy::WriteBack() const
 {
-    std::vector<UnitStats*> attackerUnitStats = GatherUnits(attacker, true);
-    std::vector<UnitStats*> defenderUnitStats = GatherUnits(defender, false);
-
-    bool defenderTakesReducedDamage = defender->GetPotion()->IsApplied() && defender->GetPotion()->GetType() == PotionType::REDUCE_DAMAGE;
-    BattleUnits(attackerUnitStats, defenderUnitStats, defenderTakesReducedDamage);
+    for (size_t i = 0; i < Health.size(); i++)
+    {
+        if (Source[i])
+            Source[i]->Health = Health[i];
+    }
 }
 
-void Battle::BattleUnits(const std::vector<UnitStats*>& attacker, const std::vector<UnitStats*>& defender, bool defenderTakesReducedDamage)
+BattleOutcome Battle::CalculateBattleOutcome(Tile* attacker, Tile* defender)
 {
-    size_t minUnitStatsCount = glm::min(attacker.size(), defender.size());
+    // Reused by every battle, so fighting does not allocate once the buffers have grown
+    static BattleArmy attackerArmy;
+    static BattleArmy defenderArmy;
 
-    int reducedDefenderDamageValue = defenderTakesReducedDamage ? 1 : 0;
-    for (size_t i = 0; i < minUnitStatsCount; i++)
+    GatherUnits(attacker, true, attackerArmy);
+    GatherUnits(defender, false, defenderArmy);
+
+    if (Simulate(attackerArmy, defenderArmy, DefenderTakesReducedDamage(defender)) > 0)
     {
-        OneVOne(attacker[i], defender[i], reducedDefenderDamageValue);
+        attackerArmy.WriteBack();
+        defenderArmy.WriteBack();
+        CleanupUnits(attacker, true);
+        CleanupUnits(defender, false);
     }
 
-    if (attacker.size() > defender.size())
+    return attackerArmy.GetTotalHealth() > 0 ? BattleOutcome::ATTACKER_WON : BattleOutcome::DEFENDER_WON;
+}
+
+BattlePrediction Battle::Predict(Tile* attacker, Tile* defender, bool checkSelectedOnly)
+{
+    static BattleArmy attackerArmy;
+    static BattleArmy defenderArmy;
+    static std::vector<int> key;
+
+    GatherUnits(attacker, checkSelectedOnly, attackerArmy, false);
+    GatherUnits(defender, false, defenderArmy, false);
+    bool defenderTakesReducedDamage = DefenderTakesReducedDamage(defender);
+
+    // Units are paired by their position, so the order of the stats is part of the key
+    key.clear();
+    key.push_back(defenderTakesReducedDamage ? 1 : 0);
+    key.push_back((int)attackerArmy.Size());
+    for (const BattleArmy* army : { &attackerArmy, &defenderArmy })
     {
-        for (size_t i = minUnitStatsCount; i < attacker.size(); i++)
+        for (size_t i = 0; i < army->Size(); i++)
         {
-            OneVOne(attacker[i], defender[i % minUnitStatsCount], reducedDefenderDamageValue);
+            key.push_back(army->Attack[i]);
+            key.push_back(army->Defense[i]);
+            key.push_back(army->Health[i]);
         }
     }
-    else
+
+    uint64_t hash = HashPredictionKey(key);
+    auto it = s_PredictionCache.find(hash);
+    if (it != s_PredictionCache.end() && it->second.Key == key)
+        return it->second.Prediction;
+
+    int attackerUnitCount = attackerArmy.Size();
+    int defenderUnitCount = defenderArmy.Size();
+    Simulate(attackerArmy, defenderArmy, defenderTakesReducedDamage);
+
+    BattlePrediction prediction;
+    prediction.AttackerHealth = attackerArmy.GetTotalHealth();
+    prediction.DefenderHealth = defenderArmy.GetTotalHealth();
+    prediction.Outcome = prediction.AttackerHealth > 0 ? BattleOutcome::ATTACKER_WON : BattleOutcome::DEFENDER_WON;
+    prediction.AttackerSurvivors = attackerArmy.Size();
+    prediction.DefenderSurvivors = defenderArmy.Size();
+    prediction.AttackerLosses = attackerUnitCount - prediction.AttackerSurvivors;
+    prediction.DefenderLosses = defenderUnitCount - prediction.DefenderSurvivors;
+
+    if (s_PredictionCache.size() >= BATTLE_PREDICTION_CACHE_CAPACITY)
+        s_PredictionCache.clear();
+
+    auto& entry = s_PredictionCache[hash];
+    entry.Key = key;
+    entry.Prediction = prediction;
+    return prediction;
+}
+
+void Battle::ClearPredictionCache()
+{
+    s_PredictionCache.clear();
+}
+
+int Battle::Simulate(BattleArmy& attacker, BattleArmy& defender, bool defenderTakesReducedDamage)
+{
+    int reducedDefenderDamageValue = defenderTakesReducedDamage ? 1 : 0;
+
+    int ticks = 0;
+    while (attacker.GetTotalHealth() > 0 && defender.GetTotalHealth() > 0)
     {
-        for (size_t i = minUnitStatsCount; i < defender.size(); i++)
-        {
-            OneVOne(defender[i], attacker[i % minUnitStatsCount], reducedDefenderDamageValue);
-        }
+        SimulateTick(attacker, defender, reducedDefenderDamageValue);
+        attacker.RemoveDeadUnits();
+        defender.RemoveDeadUnits();
+        ticks++;
     }
+
+    return ticks;
 }
 
-std::vector<UnitStats*> Battle::GatherUnits(const std::shared_ptr<Tile>& tile, bool checkSelectedOnly)
+void Battle::GatherUnits(Tile* tile, bool checkSelectedOnly, BattleArmy& army, bool linkToTile)
 {
-    std::vector<UnitStats*> unitStats;
+    army.Clear();
 
     for (UnitGroup* unitGroup : tile->GetUnitGroups())
     {
         if (checkSelectedOnly && !unitGroup->IsSelected())
             continue;
 
-        unitStats.insert(unitStats.end(), unitGroup->GetUnitStats().begin(), unitGroup->GetUnitStats().end());
+        for (UnitStats* stats : unitGroup->GetUnitStats())
+            army.Add(*stats, linkToTile ? stats : nullptr);
     }
-
-    return unitStats;
 }
 
-void Battle::OneVOne(UnitStats* us1, UnitStats* us2, int reducedDefenderDamageValue)
+bool Battle::DefenderTakesReducedDamage(Tile* defender)
 {
-    if (us1->Health <= 0 || us2->Health <= 0) return;
+    return defender->GetPotion().IsApplied() && defender->GetPotion().GetType() == PotionType::REDUCE_DAMAGE;
+}
 
-    us2->Health -= glm::max(us1->Attack - us2->Defense - reducedDefenderDamageValue, 1);
-    us1->Health -= glm::max(us2->Attack - us1->Defense, 1);
+void Battle::SimulateTick(BattleArmy& attacker, BattleArmy& defender, int reducedDefenderDamageValue)
+{
+    size_t minUnitCount = glm::min(attacker.Size(), defender.Size());
+
+    // Units facing each other are disjoint pairs, so this part has no dependencies between
+    // iterations and is written without branches to let the compiler vectorize it
+    int* attackerAttack = attacker.Attack.data();
+    int* attackerDefense = attacker.Defense.data();
+    int* attackerHealth = attacker.Health.data();
+    int* defenderAttack = defender.Attack.data();
+    int* defenderDefense = defender.Defense.data();
+    int* defenderHealth = defender.Health.data();
+    for (size_t i = 0; i < minUnitCount; i++)
+    {
+        bool fight = attackerHealth[i] > 0 && defenderHealth[i] > 0;
+        int damageToDefender = glm::max(attackerAttack[i] - defenderDefense[i] - reducedDefenderDamageValue, 1);
+        int damageToAttacker = glm::max(defenderAttack[i] - attackerDefense[i], 1);
+        defenderHealth[i] = fight ? glm::max(defenderHealth[i] - damageToDefender, 0) : defenderHealth[i];
+        attackerHealth[i] = fight ? glm::max(attackerHealth[i] - damageToAttacker, 0) : attackerHealth[i];
+    }
 
-    us2->Health = glm::max(us2->Health, 0);
-    us1->Health = glm::max(us1->Health, 0);
+    // Units of the larger army left over attack again from the start, one after another
+    if (attacker.Size() > defender.Size())
+    {
+        for (size_t i = minUnitCount; i < attacker.Size(); i++)
+            OneVOne(attacker, i, defender, i % minUnitCount, reducedDefenderDamageValue);
+    }
+    else
+    {
+        for (size_t i = minUnitCount; i < defender.Size(); i++)
+            OneVOne(defender, i, attacker, i % minUnitCount, reducedDefenderDamageValue);
+    }
 }
 
-void Battle::CleanupBattleField(const std::shared_ptr<Tile>& attacker, const std::shared_ptr<Tile>& defender)
+void Battle::OneVOne(BattleArmy& army1, size_t unit1, BattleArmy& army2, size_t unit2, int reducedDefenderDamageValue)
 {
-    CleanupUnits(attacker, true);
-    CleanupUnits(defender, false);
+    int& health1 = army1.Health[unit1];
+    int& health2 = army2.Health[unit2];
+    if (health1 <= 0 || health2 <= 0) return;
+
+    health2 -= glm::max(army1.Attack[unit1] - army2.Defense[unit2] - reducedDefenderDamageValue, 1);
+    health1 -= glm::max(army2.Attack[unit2] - army1.Defense[unit1], 1);
+
+    health2 = glm::max(health2, 0);
+    health1 = glm::max(health1, 0);
 }
 
-void Battle::CleanupUnits(const std::shared_ptr<Tile>& tile, bool checkSelectedOnly)
+void Battle::CleanupUnits(Tile* tile, bool checkSelectedOnly)
 {
     for (UnitGroup* unitGroup : tile->GetUnitGroups())
     {
         if (checkSelectedOnly && !unitGroup->IsSelected())
             continue;
 
-        auto& stats = unitGroup->GetUnitStats();
-        Util::RemoveElementsFromContainerWithCondition<std::vector<UnitStats*>, UnitStats*>(
-            stats,
-            [](UnitStats* us) {
-                return us->Health <= 0;
-            }
-        );
+        unitGroup->RemoveDeadUnits();
     }
 
-    auto& unitGroups = tile->GetUnitGroups();
-    Util::RemoveElementsFromContainerWithCondition<std::vector<UnitGroup*>, UnitGroup*>(
-        unitGroups,
-        [](UnitGroup* ug) {
-            return ug->GetUnitStats().empty();
-        }
-    );
+    tile->DestroyUnitGroups([](UnitGroup* ug) {
+        return ug->GetUnitStats().empty();
+    });
 }
 
-int Battle::GetTotalUnitGroupHealth(const std::shared_ptr<Tile>& tile, bool checkSelectedOnly)
+uint64_t Battle::HashPredictionKey(const std::vector<int>& key)
 {
-    int totalHealth = 0;
-
-    for (UnitGroup* unitGroup : tile->GetUnitGroups())
+    // FNV-1a over the values
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (int value : key)
     {
-        if (checkSelectedOnly && !unitGroup->IsSelected())
-            continue;
-
-        totalHealth = std::accumulate(
-            unitGroup->GetUnitStats().begin(),
-            unitGroup->GetUnitStats().end(),
-            totalHealth,
-            [](int acc, const UnitStats* const stats) {
-                return acc + stats->Health;
-            }
-        );
+        hash ^= (uint32_t)value;
+        hash *= 0x100000001b3ull;
     }
 
-    return totalHealth;
+    return hash;
 }
@@ -1,26 +1,79 @@
 #pragma once
 
 #include <memory>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
 
 #include "game/tile.h"
 
+// number of predicted battles remembered, the cache starts over once it is full
+#define BATTLE_PREDICTION_CACHE_CAPACITY 4096
+
 enum class BattleOutcome
 {
     ATTACKER_WON,
     DEFENDER_WON
 };
 
+struct BattlePrediction
+{
+    BattleOutcome Outcome;
+    int AttackerSurvivors;
+    int DefenderSurvivors;
+    int AttackerLosses;
+    int DefenderLosses;
+    // total health left on each side
+    int AttackerHealth;
+    int DefenderHealth;
+};
+
+// Stats of one side of a battle kept in separate arrays, so a tick runs over packed integers
+// instead of chasing a pointer per unit. Buffers keep their memory between battles.
+struct BattleArmy
+{
+    std::vector<int> Attack;
+    std::vector<int> Defense;
+    std::vector<int> Health;
+    // unit the stats were copied from, nullptr when the army is only simulated
+    std::vector<UnitStats*> Source;
+
+    void Clear();
+    void Add(const UnitStats& stats, UnitStats* source = nullptr);
+    inline size_t Size() const { return Health.size(); }
+    int GetTotalHealth() const;
+    // Keeps the order of the remaining units, the health of removed ones is written to their source
+    void RemoveDeadUnits();
+    void WriteBack() const;
+};
+
 class Battle
 {
 public:
-    static BattleOutcome CalculateBattleOutcome(const std::shared_ptr<Tile>& attacker, const std::shared_ptr<Tile>& defender);
+    static BattleOutcome CalculateBattleOutcome(Tile* attacker, Tile* defender);
+    // Result of attacking with the selected unit groups, or with all of them, without changing either tile.
+    // Predictions are remembered by the stats of both sides, so asking again costs only a lookup.
+    static BattlePrediction Predict(Tile* attacker, Tile* defender, bool checkSelectedOnly = true);
+    static void ClearPredictionCache();
+    // Fights until one side has no health left, returns the number of simulated ticks
+    static int Simulate(BattleArmy& attacker, BattleArmy& defender, bool defenderTakesReducedDamage);
+    // Without linking, the army is a copy and simulating it leaves the tile untouched
+    static void GatherUnits(Tile* tile, bool checkSelectedOnly, BattleArmy& army, bool linkToTile = true);
+    static bool DefenderTakesReducedDamage(Tile* defender);
 
 private:
-    static void SimulateBattleTick(const std::shared_ptr<Tile>& attacker, const std::shared_ptr<Tile>& defender);
-    static void BattleUnits(const std::vector<UnitStats*>& attacker, const std::vector<UnitStats*>& defender, bool defenderTakesReducedDamage = false);
-    static std::vector<UnitStats*> GatherUnits(const std::shared_ptr<Tile>& tile, bool checkSelectedOnly);
-    static void OneVOne(UnitStats* us1, UnitStats* us2, int reducedDefenderDamageValue);
-    static void CleanupBattleField(const std::shared_ptr<Tile>& attacker, const std::shared_ptr<Tile>& defender);
-    static void CleanupUnits(const std::shared_ptr<Tile>& tile, bool checkSelectedOnly);
-    static int GetTotalUnitGroupHealth(const std::shared_ptr<Tile>& tile, bool checkSelectedOnly);
+    static void SimulateTick(BattleArmy& attacker, BattleArmy& defender, int reducedDefenderDamageValue);
+    static void OneVOne(BattleArmy& army1, size_t unit1, BattleArmy& army2, size_t unit2, int reducedDefenderDamageValue);
+    static void CleanupUnits(Tile* tile, bool checkSelectedOnly);
+    static uint64_t HashPredictionKey(const std::vector<int>& key);
+
+private:
+    struct PredictionCacheEntry
+    {
+        // stats of both sides and the potion state, compared on lookup since hashes can collide
+        std::vector<int> Key;
+        BattlePrediction Prediction;
+    };
+
+    static std::unordered_map<uint64_t, PredictionCacheEntry> s_PredictionCache;
 };
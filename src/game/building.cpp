@@ -1,5 +1,7 @@
 #include "building.h"
 
+ObjectPool<Building> BuildingPool("building");
+
 std::unordered_map<BuildingType, BuildingData> BuildingDataMap = {
     { BuildingType::GOLD_MINE,    { { 10, 25, 15, 10 }, { 3, 4, 3, 5 },    "gold_mine" } },
     { BuildingType::TARGET,       { { 30, 30, 25, 25 }, { 2, 4, 4, 3 },       "target" } },
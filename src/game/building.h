@@ -3,6 +3,7 @@
 #include <string>
 #include <unordered_map>
 
+#include "core/object_pool.h"
 #include "game/resource.h"
 
 enum class BuildingType
@@ -44,8 +45,11 @@ private:
     unsigned int m_Level;
 };
 
+extern ObjectPool<Building> BuildingPool;
+
 struct BuildingUpgradeInfo
 {
     bool Show;
-    Building* _Building;
+    // handle instead of a pointer, the building can be gone by the time the info is drawn
+    PoolHandle BuildingHandle;
 };
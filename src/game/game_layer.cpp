@@ -1,10 +1,13 @@
 #include "game_layer.h"
 
+#include <sstream>
+
 #include <imgui/imgui.h>
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
 #include "game/tile.h"
+#include "game/battle.h"
 #include "debug/debug_data.h"
 #include "core/input.h"
 #include "core/logger.h"
@@ -29,6 +32,11 @@ GameLayer::GameLayer()
     m_GameMapManager = std::make_shared<GameMapManager>("");
     m_PlayerManager = std::make_shared<PlayerManager>();
     m_Arrow = std::make_shared<Arrow>();
+    m_TerrainInstances = std::make_shared<HexagonInstances>();
+    m_TerrainChunks = std::make_unique<TerrainChunkCache>();
+    m_Ocean = std::make_unique<Ocean>();
+    m_TileEffects = std::make_unique<TileEffects>();
+    m_TerritoryOutline = std::make_unique<TerritoryOutline>();
 }
 
 void GameLayer::OnAttach()
@@ -44,6 +52,13 @@ void GameLayer::OnUpdate(float dt)
     m_CameraController->OnUpdate(dt);
     auto camera = m_CameraController->GetCamera();
 
+    // Only tiles around the view are drawn and tested for hover
+    TileRange visibleRange = m_GameMapManager->GetGameMap()->GetVisibleTileRange(camera);
+    TileDetail tileDetail = Tile::CalculateDetail(camera);
+
+    // Chunks are rendered into their own framebuffers, so this happens before the scene begins
+    m_TerrainChunks->Update(m_GameMapManager->GetGameMap(), camera, visibleRange);
+
     Renderer2D::ClearColor({0.2f, 0.2f, 0.2f, 1.0f});
 
     Renderer2D::BeginScene(camera);
@@ -52,55 +67,107 @@ void GameLayer::OnUpdate(float dt)
     auto relMousePos = camera->CalculateRelativeMousePosition();
     bool isCursorOnAdjacentTile = false;
 
+    // Picked once per frame, input handlers and the shop panel reuse the same hovered tile
+    m_HoveredTile = m_GameMapManager->GetGameMap()->FindTile(relMousePos);
+
     struct
     {
         bool NotEnoughSpace = false;
         glm::vec2 Position;
     } notEnoughSpaceInfo;
 
-    for (int y = 0; y < m_GameMapManager->GetGameMap()->GetTileCountY(); y++)
+    struct
+    {
+        bool Show = false;
+        glm::vec2 Position;
+        glm::vec3 Color;
+        std::string Text;
+    } battlePreviewInfo;
+
+    // Tiles interleave many shaders, queueing the map groups them into a few draws per layer
+    Renderer2D::BeginQueue();
+
+    m_TileEffects->Update(m_GameMapManager->GetGameMap(), currentPlayer, m_IterationNumber);
+
+    Renderer2D::SetLayer(RenderLayer::BACKGROUND);
+    m_TileEffects->DrawOwnershipGlow();
+
+    // Up close chunk textures would get too large, the terrain is then drawn in one instanced call with the decorations per tile
+    Renderer2D::SetLayer(RenderLayer::TERRAIN);
+    bool terrainCached = m_TerrainChunks->Draw(visibleRange);
+    if (!terrainCached)
     {
-        for (int x = 0; x < m_GameMapManager->GetGameMap()->GetTileCountX(); x++)
+        UpdateTerrainInstances();
+        Renderer2D::DrawHexagonInstances(m_TerrainInstances);
+    }
+
+    m_Ocean->Update(m_GameMapManager->GetGameMap());
+    m_Ocean->Draw();
+
+    if (m_HoveredTile)
+    {
+        auto startTile = m_Arrow->GetStartTile();
+        if (startTile && Tile::IsAdjacent(m_HoveredTile->GetCoords(), startTile->GetCoords()) &&
+            m_HoveredTile->GetEnvironment() != TileEnvironment::NONE)
         {
-            auto tile = m_GameMapManager->GetGameMap()->GetTile(x, y);
+            isCursorOnAdjacentTile = true;
+            m_Arrow->SetEndPosition(m_HoveredTile->GetPosition());
+            m_Arrow->SetVisible(true);
+
+            if (m_HoveredTile->GetOwnedBy() == currentPlayer.get() &&
+               !m_HoveredTile->HasSpaceForUnitGroups(startTile->GetNumSelectedUnitGroups()))
+            {
+                m_Arrow->SetColor({1.0f, 0.0f, 0.0f, 1.0f});
 
-            bool isCursorOnTile = false;
-            if (!isCursorOnAdjacentTile && tile->InRange(relMousePos))
+                notEnoughSpaceInfo.NotEnoughSpace = true;
+                notEnoughSpaceInfo.Position = {
+                    startTile->GetPosition().x + (m_HoveredTile->GetPosition().x - startTile->GetPosition().x) / 2.0f,
+                    startTile->GetPosition().y + (m_HoveredTile->GetPosition().y - startTile->GetPosition().y) / 2.0f
+                };
+            }
+            else
             {
-                auto startTile = m_Arrow->GetStartTile();
-                if (startTile && Tile::IsAdjacent({x, y}, startTile->GetCoords()) && tile->GetEnvironment() != TileEnvironment::NONE)
+                m_Arrow->SetColor({0.0f, 1.0f, 1.0f, 1.0f});
+            }
+
+            // Losses are previewed before the attack is committed
+            if (m_Arrow->IsActivated() && m_HoveredTile->GetOwnedBy() != currentPlayer.get() && m_HoveredTile->AssetsCanExist())
+            {
+                battlePreviewInfo.Show = true;
+                battlePreviewInfo.Position = (startTile->GetPosition() + m_HoveredTile->GetPosition()) / 2.0f;
+
+                std::ostringstream oss;
+                if (m_HoveredTile->GetPotion().IsApplied() && m_HoveredTile->GetPotion().GetType() == PotionType::IMMUNITY)
                 {
-                    isCursorOnAdjacentTile = true;
-                    m_Arrow->SetEndPosition(tile->GetPosition());
-                    m_Arrow->SetVisible(true);
-
-                    if (tile->GetOwnedBy() == currentPlayer &&
-                       !tile->HasSpaceForUnitGroups(m_Arrow->GetStartTile()->GetNumSelectedUnitGroups()))
-                    {
-                        m_Arrow->SetColor({1.0f, 0.0f, 0.0f, 1.0f});
-
-                        notEnoughSpaceInfo.NotEnoughSpace = true;
-                        notEnoughSpaceInfo.Position = {
-                            m_Arrow->GetStartTile()->GetPosition().x + (tile->GetPosition().x - m_Arrow->GetStartTile()->GetPosition().x) / 2.0f,
-                            m_Arrow->GetStartTile()->GetPosition().y + (tile->GetPosition().y - m_Arrow->GetStartTile()->GetPosition().y) / 2.0f
-                        };
-                    }
-                    else
-                    {
-                        m_Arrow->SetColor({0.0f, 1.0f, 1.0f, 1.0f});
-                    }
+                    oss << "Immune";
+                    battlePreviewInfo.Color = glm::vec3(1.0f);
                 }
                 else
                 {
-                    m_Arrow->SetVisible(false);
+                    BattlePrediction prediction = Battle::Predict(startTile, m_HoveredTile);
+                    bool won = prediction.Outcome == BattleOutcome::ATTACKER_WON;
+                    oss << (won ? "Win" : "Lose") << ": -" << prediction.AttackerLosses << " / -" << prediction.DefenderLosses;
+                    battlePreviewInfo.Color = won ? glm::vec3(0.4f, 1.0f, 0.4f) : glm::vec3(1.0f, 0.4f, 0.4f);
                 }
-
-                isCursorOnTile = true;
+                battlePreviewInfo.Text = oss.str();
             }
+        }
+        else
+        {
+            m_Arrow->SetVisible(false);
+        }
+    }
+
+    for (int y = visibleRange.StartY; y < visibleRange.EndY; y++)
+    {
+        for (int x = visibleRange.StartX; x < visibleRange.EndX; x++)
+        {
+            auto tile = m_GameMapManager->GetGameMap()->GetTile(x, y);
 
-            tile->Draw();
-            if (isCursorOnTile)
+            tile->Draw(tileDetail, !terrainCached);
+            if (tile == m_HoveredTile)
             {
+                Renderer2D::SetLayer(RenderLayer::OVERLAY);
                 Renderer2D::DrawHexagon(
                     tile->GetPosition(),
                     glm::vec2(1.0f),
@@ -114,9 +181,17 @@ void GameLayer::OnUpdate(float dt)
         }
     }
 
+    Renderer2D::SetLayer(RenderLayer::OBJECTS);
+    m_TerritoryOutline->Update(m_GameMapManager->GetGameMap());
+    m_TerritoryOutline->Draw();
+
+    Renderer2D::SetLayer(RenderLayer::EFFECTS);
+    m_TileEffects->DrawPotionEffects();
+
     if (m_Arrow->IsVisible() && !isCursorOnAdjacentTile)
         m_Arrow->SetEndPosition(m_Arrow->GetStartTile()->GetPosition());
 
+    Renderer2D::SetLayer(RenderLayer::OVERLAY);
     if (m_Arrow->IsActivated() && m_Arrow->IsVisible())
         m_Arrow->Draw();
 
@@ -131,9 +206,35 @@ void GameLayer::OnUpdate(float dt)
         );
     }
 
+    if (battlePreviewInfo.Show && m_Arrow->IsVisible())
+    {
+        Renderer2D::DrawTextStr(
+            battlePreviewInfo.Text,
+            battlePreviewInfo.Position,
+            0.6f / camera->GetZoom(),
+            battlePreviewInfo.Color,
+            HTextAlign::MIDDLE
+        );
+    }
+
+    Renderer2D::EndQueue();
     Renderer2D::EndScene();
 }
 
+// Terrain never changes during a game, so instances are only rebuilt after a different map is loaded
+void GameLayer::UpdateTerrainInstances()
+{
+    const auto& gameMap = m_GameMapManager->GetGameMap();
+    if (m_TerrainInstancesMap == gameMap)
+        return;
+
+    m_TerrainInstances->Clear();
+    for (const auto& tile : gameMap->GetTiles())
+        tile.SubmitTerrain(m_TerrainInstances);
+
+    m_TerrainInstancesMap = gameMap;
+}
+
 void GameLayer::OnEvent(Event& event)
 {
     m_CameraController->OnEvent(event);
@@ -175,30 +276,15 @@ bool GameLayer::OnKeyPressed(KeyPressedEvent& event)
 
 void GameLayer::SelectAllIfInRange()
 {
-    auto relMousePos = m_CameraController->GetCamera()->CalculateRelativeMousePosition();
-
-    for (int y = 0; y < m_GameMapManager->GetGameMap()->GetTileCountY(); y++)
-    {
-        for (int x = 0; x < m_GameMapManager->GetGameMap()->GetTileCountX(); x++)
-        {
-            auto tile = m_GameMapManager->GetGameMap()->GetTile(x, y);
-
-            if (!tile->InRange(relMousePos))
-                continue;
-
-            if (tile->GetOwnedBy() != m_PlayerManager->GetCurrentPlayer())
-                continue;
-
-            if (m_Arrow->GetStartTile())
-                m_Arrow->GetStartTile()->DeselectAllUnitGroups();
+    if (!m_HoveredTile || m_HoveredTile->GetOwnedBy() != m_PlayerManager->GetCurrentPlayer().get())
+        return;
 
-            tile->SelectAllUnitGroups();
-            m_Arrow->SetStartTile(tile);
-            m_Arrow->SetActivated(tile && tile->HasSelectedUnitGroups());
+    if (m_Arrow->GetStartTile())
+        m_Arrow->GetStartTile()->DeselectAllUnitGroups();
 
-            return;
-        }
-    }
+    m_HoveredTile->SelectAllUnitGroups();
+    m_Arrow->SetStartTile(m_HoveredTile);
+    m_Arrow->SetActivated(m_HoveredTile->HasSelectedUnitGroups());
 }
 
 bool GameLayer::OnKeyReleased(KeyReleasedEvent& event)
@@ -214,6 +300,10 @@ bool GameLayer::OnKeyReleased(KeyReleasedEvent& event)
 
 void GameLayer::InitGame(NewGameDTO newGameData)
 {
+    // Tiles of the previous map are released together with it
+    m_HoveredTile = nullptr;
+    m_Arrow = std::make_shared<Arrow>();
+
     if (newGameData.MapData.has_value())
         m_GameMapManager->Load(newGameData.MapName, newGameData.MapData.value());
     else
@@ -246,28 +336,18 @@ void GameLayer::InitGame(NewGameDTO newGameData)
 
     if (!newGameData.LoadedFromSave)
     {
-        for (int y = 0; y < m_GameMapManager->GetGameMap()->GetTileCountY(); y++)
+        for (auto& tile : m_GameMapManager->GetGameMap()->GetTiles())
         {
-            for (int x = 0; x < m_GameMapManager->GetGameMap()->GetTileCountX(); x++)
-            {
-                auto tile = m_GameMapManager->GetGameMap()->GetTile(x, y);
-                if (tile->AssetsCanExist() && !tile->IsOwned())
-                    tile->AddRandomUnits();
-            }
+            if (tile.AssetsCanExist() && !tile.IsOwned())
+                tile.AddRandomUnits();
         }
     }
 }
 
 void GameLayer::NextIteration()
 {
-    for (int y = 0; y < m_GameMapManager->GetGameMap()->GetTileCountY(); y++)
-    {
-        for (int x = 0; x < m_GameMapManager->GetGameMap()->GetTileCountX(); x++)
-        {
-            auto tile = m_GameMapManager->GetGameMap()->GetTile(x, y);
-            tile->TickPotion();
-        }
-    }
+    for (auto& tile : m_GameMapManager->GetGameMap()->GetTiles())
+        tile.TickPotion();
 
     m_IterationNumber++;
 }
@@ -298,19 +378,11 @@ bool GameLayer::OnMouseButtonPressed(MouseButtonPressedEvent& event)
         {
             auto currentPlayer = m_PlayerManager->GetCurrentPlayer();
 
-            for (int y = 0; y < m_GameMapManager->GetGameMap()->GetTileCountY(); y++)
+            if (m_HoveredTile)
             {
-                for (int x = 0; x < m_GameMapManager->GetGameMap()->GetTileCountX(); x++)
-                {
-                    auto tile = m_GameMapManager->GetGameMap()->GetTile(x, y);
-
-                    if (!tile->InRange(relMousePos))
-                        continue;
-
-                    ProcessTileInRange(tile, currentPlayer, relMousePos);
-                    m_Arrow->SetActivated(m_Arrow->GetStartTile() && m_Arrow->GetStartTile()->HasSelectedUnitGroups());
-                    return true;
-                }
+                ProcessTileInRange(m_HoveredTile, currentPlayer, relMousePos);
+                m_Arrow->SetActivated(m_Arrow->GetStartTile() && m_Arrow->GetStartTile()->HasSelectedUnitGroups());
+                return true;
             }
 
             // If no tile in range then deselect all unit groups
@@ -326,7 +398,7 @@ bool GameLayer::OnMouseButtonPressed(MouseButtonPressedEvent& event)
 
 }
 
-void GameLayer::ProcessTileInRange(const std::shared_ptr<Tile>& tile, const std::shared_ptr<Player>& currentPlayer, const glm::vec2& relMousePos)
+void GameLayer::ProcessTileInRange(Tile* tile, const std::shared_ptr<Player>& currentPlayer, const glm::vec2& relMousePos)
 {
     if (!m_Arrow->GetStartTile()) m_Arrow->SetStartTile(tile);
 
@@ -349,21 +421,21 @@ void GameLayer::ProcessTileInRange(const std::shared_ptr<Tile>& tile, const std:
             }
 
             // If the tile is owned by the moving player and it has no space for units then return
-            if (tile->GetOwnedBy() == currentPlayer &&
+            if (tile->GetOwnedBy() == currentPlayer.get() &&
                !tile->HasSpaceForUnitGroups(m_Arrow->GetStartTile()->GetNumSelectedUnitGroups()))
                 return;
 
             // Otherwise move units to tile
             m_Arrow->GetStartTile()->MoveToTile(tile);
         }
-        else if (tile->GetOwnedBy() == currentPlayer)
+        else if (tile->GetOwnedBy() == currentPlayer.get())
         {
             m_Arrow->SetStartTile(tile);
             tile->HandleUnitGroupMouseClick(relMousePos);
             tile->HandleBuildingUpgradeIconMouseClick(relMousePos);
         }
     } // If the tile is owned by the current player and a unit grup or unit group box has not been clicked then deselect
-    else if (tile->GetOwnedBy() == currentPlayer &&
+    else if (tile->GetOwnedBy() == currentPlayer.get() &&
             !tile->HandleUnitGroupMouseClick(relMousePos) &&
             !tile->HandleBuildingUpgradeIconMouseClick(relMousePos) &&
             !tile->IsMouseClickedInsideUnitGroupsBox(relMousePos))
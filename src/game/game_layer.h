@@ -11,8 +11,13 @@
 #include "graphics/buffer.h"
 #include "graphics/texture.h"
 #include "graphics/vertex_array.h"
+#include "graphics/hexagon_instances.h"
 #include "game/map_manager.h"
 #include "game/arrow.h"
+#include "game/terrain_chunk_cache.h"
+#include "game/ocean.h"
+#include "game/tile_effects.h"
+#include "game/territory_outline.h"
 #include "game/player_manager.h"
 #include "game/color_data.h"
 
@@ -44,6 +49,8 @@ public:
     inline const std::shared_ptr<GameMapManager>& GetGameMapManager() const { return m_GameMapManager; }
     inline const std::shared_ptr<PlayerManager>& GetPlayerManager() const { return m_PlayerManager; }
     inline bool IsGameActive() const { return m_GameActive; }
+    // Tile under the cursor, picked once per frame, nullptr when the cursor is not over any tile
+    inline Tile* GetHoveredTile() const { return m_HoveredTile; }
     inline int GetIteration() { return m_IterationNumber; }
 
     bool IsEarnedResourcesInfoVisible() { return m_ShowEarnedResourcesInfo; }
@@ -65,8 +72,9 @@ private:
     bool OnMouseButtonPressed(MouseButtonPressedEvent& event);
     bool OnKeyPressed(KeyPressedEvent& event);
     bool OnKeyReleased(KeyReleasedEvent& event);
-    void ProcessTileInRange(const std::shared_ptr<Tile>& tile, const std::shared_ptr<Player>& currentPlayer, const glm::vec2& relMousePos);
+    void ProcessTileInRange(Tile* tile, const std::shared_ptr<Player>& currentPlayer, const glm::vec2& relMousePos);
     void SelectAllIfInRange();
+    void UpdateTerrainInstances();
 
 private:
     static GameLayer* s_Instance;
@@ -75,6 +83,13 @@ private:
     std::shared_ptr<GameMapManager> m_GameMapManager;
     std::shared_ptr<PlayerManager> m_PlayerManager;
     std::shared_ptr<Arrow> m_Arrow;
+    Tile* m_HoveredTile = nullptr;
+    std::shared_ptr<HexagonInstances> m_TerrainInstances;
+    std::shared_ptr<GameMap> m_TerrainInstancesMap;
+    std::unique_ptr<TerrainChunkCache> m_TerrainChunks;
+    std::unique_ptr<Ocean> m_Ocean;
+    std::unique_ptr<TileEffects> m_TileEffects;
+    std::unique_ptr<TerritoryOutline> m_TerritoryOutline;
     int m_IterationNumber;
     bool m_GameActive;
     bool m_ShowEarnedResourcesInfo;
@@ -3,17 +3,81 @@
 #include "core/logger.h"
 #include "game/tile.h"
 
-GameMap::GameMap(MapData& mapData)
-    : m_MapData(mapData)
+GameMap::GameMap(int tileCountX, int tileCountY, const std::vector<TileEnvironment>& environments)
+    : m_TileCountX(tileCountX), m_TileCountY(tileCountY)
 {
+    if (environments.size() != (size_t)(tileCountX * tileCountY))
+        LOG_WARN("GameMap::GameMap: expected {0} tile environments, got {1}", tileCountX * tileCountY, environments.size());
+
+    // Reserved up front, tiles must not be moved once other objects point to them
+    m_Tiles.reserve(tileCountX * tileCountY);
+    for (int y = 0; y < tileCountY; y++)
+    {
+        for (int x = 0; x < tileCountX; x++)
+        {
+            size_t index = y * tileCountX + x;
+            TileEnvironment environment = index < environments.size() ? environments[index] : TileEnvironment::NONE;
+            m_Tiles.emplace_back(environment, glm::ivec2(x, y));
+        }
+    }
 }
 
-const std::shared_ptr<Tile>& GameMap::GetTile(int x, int y)
+Tile* GameMap::GetTile(int x, int y)
 {
     if (x < GetTileCountX() && y < GetTileCountY() && x > -1 && y > -1)
-        return m_MapData[y][x];
+        return &m_Tiles[y * m_TileCountX + x];
 
     LOG_WARN("Map: Tile coords ({0},{1}) out of range", x, y);
-    static auto tile = std::make_shared<Tile>(TileEnvironment::NONE, glm::ivec2(x, y));
-    return tile;
+    static Tile tile(TileEnvironment::NONE, glm::ivec2(x, y));
+    return &tile;
+}
+
+TileRange GameMap::GetVisibleTileRange(const std::shared_ptr<OrthographicCamera>& camera) const
+{
+    // Bounding box of the possibly rotated view, padded by a whole tile since glows and labels spill over tile borders
+    float r = glm::radians(camera->GetRotation());
+    float halfWidth = camera->GetHalfOfRelativeWidth();
+    float halfHeight = camera->GetHalfOfRelativeHeight();
+    glm::vec2 halfExtent = {
+        glm::abs(glm::cos(r)) * halfWidth + glm::abs(glm::sin(r)) * halfHeight + TILE_WIDTH,
+        glm::abs(glm::sin(r)) * halfWidth + glm::abs(glm::cos(r)) * halfHeight + TILE_HEIGHT
+    };
+
+    glm::vec2 bottomLeft = glm::vec2(camera->GetPosition()) - halfExtent;
+    glm::vec2 topRight = glm::vec2(camera->GetPosition()) + halfExtent;
+
+    // Inverse of Tile::CalculateTilePosition, odd columns are shifted up by half a row
+    float columnStep = TILE_WIDTH * 3.0f / 4.0f + TILE_OFFSET / 2.0f * glm::sqrt(3.0f);
+    float rowStep = TILE_HEIGHT + TILE_OFFSET;
+
+    TileRange range;
+    range.StartX = glm::max(0, (int)glm::floor(bottomLeft.x / columnStep));
+    range.StartY = glm::max(0, (int)glm::floor((bottomLeft.y - rowStep / 2.0f) / rowStep));
+    range.EndX = glm::min(GetTileCountX(), (int)glm::ceil(topRight.x / columnStep) + 1);
+    range.EndY = glm::min(GetTileCountY(), (int)glm::ceil(topRight.y / rowStep) + 1);
+    return range;
+}
+
+Tile* GameMap::FindTile(const glm::vec2& position)
+{
+    float columnStep = TILE_WIDTH * 3.0f / 4.0f + TILE_OFFSET / 2.0f * glm::sqrt(3.0f);
+    float rowStep = TILE_HEIGHT + TILE_OFFSET;
+
+    // Tiles are narrower than two column steps, so at most two columns can contain the position.
+    // Tiles of one column are separated by gaps, so only the nearest row of each column is tested.
+    int firstColumn = glm::max(0, (int)glm::ceil((position.x - TILE_WIDTH / 2.0f) / columnStep));
+    int lastColumn = glm::min(GetTileCountX() - 1, (int)glm::floor((position.x + TILE_WIDTH / 2.0f) / columnStep));
+    for (int x = firstColumn; x <= lastColumn; x++)
+    {
+        float columnShift = (x & 1) ? rowStep / 2.0f : 0.0f;
+        int y = (int)glm::round((position.y - columnShift) / rowStep);
+        if (y < 0 || y >= GetTileCountY())
+            continue;
+
+        Tile& tile = m_Tiles[y * m_TileCountX + x];
+        if (tile.InRange(position))
+            return &tile;
+    }
+
+    return nullptr;
 }
@@ -5,21 +5,38 @@
 #include <vector>
 #include <unordered_map>
 
+#include "core/camera.h"
 #include "game/tile.h"
 
-typedef std::vector<std::vector<std::shared_ptr<Tile>>> MapData;
+// Rectangle of tile coordinates, end coordinates are exclusive
+struct TileRange
+{
+    int StartX;
+    int StartY;
+    int EndX;
+    int EndY;
+};
 
+// Tiles are kept by value in one row-major array, so passes over the whole map walk memory linearly
+// and every other object refers to tiles without owning them
 class GameMap
 {
 public:
-    GameMap(MapData& mapData);
+    // Environments are given row by row, tileCountX * tileCountY of them
+    GameMap(int tileCountX, int tileCountY, const std::vector<TileEnvironment>& environments);
     ~GameMap() = default;
 
-    inline int GetTileCountX() const { return !m_MapData.empty() ? m_MapData[0].size() : 0; }
-    inline int GetTileCountY() const { return m_MapData.size(); }
+    inline int GetTileCountX() const { return m_TileCountX; }
+    inline int GetTileCountY() const { return m_TileCountY; }
+
+    Tile* GetTile(int x, int y);
+    inline std::vector<Tile>& GetTiles() { return m_Tiles; }
 
-    const std::shared_ptr<Tile>& GetTile(int x, int y);
+    TileRange GetVisibleTileRange(const std::shared_ptr<OrthographicCamera>& camera) const;
+    // Tile under a world position, nullptr in the gaps between tiles and outside of the map
+    Tile* FindTile(const glm::vec2& position);
 
 private:
-    MapData m_MapData;
+    int m_TileCountX, m_TileCountY;
+    std::vector<Tile> m_Tiles;
 };
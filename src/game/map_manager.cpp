@@ -33,48 +33,40 @@ void GameMapManager::Load(const std::string& mapName, bool flip_vertically)
     if (flip_vertically)
         std::reverse(rows.begin(), rows.end());
 
-    int x = 0, y = 0;
     int tileCode;
-    MapData map;
+    int tileCountX = 0;
+    std::vector<TileEnvironment> environments;
     for (std::string row_str : rows)
     {
         std::istringstream sstream(row_str);
-        std::vector<std::shared_ptr<Tile>> row;
+        int x = 0;
         while (sstream >> tileCode)
         {
-            auto t = std::make_shared<Tile>((TileEnvironment)tileCode, glm::ivec2(x, y));
-            row.emplace_back(t);
+            environments.push_back((TileEnvironment)tileCode);
             x++;
         }
-        x = 0;
-        y++;
-        map.emplace_back(row);
+
+        if (tileCountX == 0)
+            tileCountX = x;
     }
 
-    m_GameMap = std::make_shared<GameMap>(map);
+    m_GameMap = std::make_shared<GameMap>(tileCountX, (int)rows.size(), environments);
     m_SelectedMap = mapName;
 }
 
 void GameMapManager::Load(const std::string& mapName, const std::vector<std::vector<std::string>>& mapData)
 {
-    MapData map;
-    for (size_t y = 0; y < mapData.size(); y++)
-    {
-        const auto& rowData = mapData[y];
-
-        std::vector<std::shared_ptr<Tile>> row;
-        for (size_t x = 0; x < rowData.size(); x++)
-        {
-            const auto& columnData = rowData[x];
+    int tileCountX = !mapData.empty() ? mapData[0].size() : 0;
+    std::vector<TileEnvironment> environments;
+    environments.reserve(tileCountX * mapData.size());
 
-            auto t = std::make_shared<Tile>((TileEnvironment)std::stoi(columnData), glm::ivec2(x, y));
-            row.emplace_back(t);
-        }
-
-        map.emplace_back(row);
+    for (const auto& rowData : mapData)
+    {
+        for (const auto& columnData : rowData)
+            environments.push_back((TileEnvironment)std::stoi(columnData));
     }
 
-    m_GameMap = std::make_shared<GameMap>(map);
+    m_GameMap = std::make_shared<GameMap>(tileCountX, (int)mapData.size(), environments);
     m_SelectedMap = mapName;
 }
 
@@ -87,4 +79,3 @@ std::string GameMapManager::GetMapPath(const std::string& mapName)
 {
     return s_MapDirectory + mapName + s_MapFileSuffix;
 }
-
@@ -0,0 +1,98 @@
+#include "ocean.h"
+
+#include <vector>
+
+#include "core/resource_manager.h"
+#include "graphics/renderer.h"
+#include "graphics/graphics_context.h"
+#include "game/tile.h"
+
+Ocean::Ocean()
+{
+    m_Instances = std::make_shared<HexagonInstances>();
+
+    if (GraphicsContext::IsSoftwareRenderer())
+    {
+        m_Shader = ResourceManager::GetShader("ocean_baked");
+        BakeAnimation();
+    }
+    else
+    {
+        m_Shader = ResourceManager::GetShader("ocean");
+    }
+}
+
+void Ocean::Update(const std::shared_ptr<GameMap>& gameMap)
+{
+    if (m_GameMap == gameMap)
+        return;
+
+    m_Instances->Clear();
+    for (const auto& tile : gameMap->GetTiles())
+    {
+        if (tile.GetEnvironment() == TileEnvironment::OCEAN)
+            m_Instances->Add(tile.GetPosition(), glm::vec2(1.0f), glm::vec4(1.0f));
+    }
+
+    m_GameMap = gameMap;
+}
+
+void Ocean::Draw()
+{
+    Renderer2D::DrawHexagonInstances(m_Instances, m_Shader, m_AnimationTexture);
+}
+
+// Evaluates the pattern of ocean.glsl on the CPU. The pattern never repeats by itself, so every frame is
+// crossfaded with the same frame one period earlier, which makes the last frame blend back into the first one.
+void Ocean::BakeAnimation()
+{
+    static const glm::vec4 waterColor = { 0.192156862745098f, 0.6627450980392157f, 0.9333333333333333f, 1.0f };
+    static const glm::mat3 pattern = {
+        glm::vec3(-2.0f, -1.0f,  0.0f),
+        glm::vec3( 3.0f, -1.0f,  1.0f),
+        glm::vec3( 1.0f, -1.0f, -1.0f)
+    };
+
+    auto evaluate = [](const glm::vec2& worldPosition, float time) {
+        glm::vec3 k = { worldPosition * 2.0f / TILE_HEIGHT * 2.0f, time * 0.8f };
+        k = k * (pattern * 0.5f);
+        float val1 = glm::length(glm::vec3(0.5f) - glm::fract(k));
+        k = k * (pattern * 0.2f);
+        float val2 = glm::length(glm::vec3(0.5f) - glm::fract(k));
+        k = k * (pattern * 0.5f);
+        float val3 = glm::length(glm::vec3(0.5f) - glm::fract(k));
+        return glm::pow(glm::min(glm::min(val1, val2), val3), 7.0f) * 3.0f;
+    };
+
+    int width = WATER_ANIMATION_FRAME_SIZE * WATER_ANIMATION_FRAME_COUNT;
+    std::vector<unsigned char> pixels(width * WATER_ANIMATION_FRAME_SIZE * 4);
+    for (int frame = 0; frame < WATER_ANIMATION_FRAME_COUNT; frame++)
+    {
+        float blend = (float)frame / WATER_ANIMATION_FRAME_COUNT;
+        float time = blend * WATER_ANIMATION_PERIOD;
+
+        for (int y = 0; y < WATER_ANIMATION_FRAME_SIZE; y++)
+        {
+            for (int x = 0; x < WATER_ANIMATION_FRAME_SIZE; x++)
+            {
+                glm::vec2 worldPosition = (glm::vec2(x, y) + 0.5f) / (float)WATER_ANIMATION_FRAME_SIZE * WATER_ANIMATION_WORLD_SIZE;
+                float highlight = glm::mix(evaluate(worldPosition, time), evaluate(worldPosition, time - WATER_ANIMATION_PERIOD), blend);
+                glm::vec4 color = glm::clamp(waterColor + glm::vec4(highlight), 0.0f, 1.0f);
+
+                int index = (y * width + frame * WATER_ANIMATION_FRAME_SIZE + x) * 4;
+                pixels[index + 0] = (unsigned char)(color.r * 255.0f);
+                pixels[index + 1] = (unsigned char)(color.g * 255.0f);
+                pixels[index + 2] = (unsigned char)(color.b * 255.0f);
+                pixels[index + 3] = (unsigned char)(color.a * 255.0f);
+            }
+        }
+    }
+
+    TextureData textureData;
+    textureData.Size = { width, WATER_ANIMATION_FRAME_SIZE };
+    textureData.Data = pixels.data();
+    textureData.NrChannels = 4;
+    textureData.WrapHorizontal = TextureWrap::CLAMP_TO_EDGE;
+    textureData.WrapVertical = TextureWrap::CLAMP_TO_EDGE;
+    m_AnimationTexture = std::make_shared<Texture2D>(textureData);
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <memory>
+
+#include "graphics/shader.h"
+#include "graphics/texture.h"
+#include "graphics/hexagon_instances.h"
+#include "game/map.h"
+
+// side of a single frame of the precomputed water animation in pixels
+#define WATER_ANIMATION_FRAME_SIZE  128
+// frames of the precomputed water animation, laid out next to each other in one texture
+#define WATER_ANIMATION_FRAME_COUNT 16
+// seconds after which the precomputed water animation repeats
+#define WATER_ANIMATION_PERIOD      10.0f
+// world units covered by a single frame of the precomputed water animation
+#define WATER_ANIMATION_WORLD_SIZE  4.0f
+
+// Every ocean tile of the map drawn as one instanced pass of a world-space water shader,
+// so the cost of the ocean does not depend on how many water tiles there are.
+// Software rasterizers sample a precomputed looping animation instead of evaluating the pattern per pixel.
+class Ocean
+{
+public:
+    Ocean();
+    ~Ocean() = default;
+
+    // Rebuilds the ocean instances after a different map is loaded
+    void Update(const std::shared_ptr<GameMap>& gameMap);
+    void Draw();
+
+private:
+    void BakeAnimation();
+
+private:
+    std::shared_ptr<HexagonInstances> m_Instances;
+    std::shared_ptr<GameMap> m_GameMap;
+    std::shared_ptr<Shader> m_Shader;
+    std::shared_ptr<Texture2D> m_AnimationTexture;
+};
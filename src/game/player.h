@@ -35,13 +35,13 @@ public:
     inline std::string GetName() { return m_Name; }
     inline glm::vec3& GetColor() { return m_Color; }
     inline Resources GetResources() { return m_Resources; }
-    inline std::vector<std::shared_ptr<Tile>>& GetOwnedTiles() { return m_OwnedTiles; }
+    inline std::vector<Tile*>& GetOwnedTiles() { return m_OwnedTiles; }
     inline bool IsAIPlayer() { return m_IsAI; }
 
     void AddResources(Resources& resources);
     bool SubtractResources(Resources& resources);
-    void AddOwnedTile(const std::shared_ptr<Tile>& tile);
-    void RemoveOwnedTile(const std::shared_ptr<Tile>& tile);
+    void AddOwnedTile(Tile* tile);
+    void RemoveOwnedTile(Tile* tile);
     void CollectResourcesFromOwnedTiles();
 
 private:
@@ -49,5 +49,5 @@ private:
     bool m_IsAI;
     glm::vec3 m_Color;
     Resources m_Resources;
-    std::vector<std::shared_ptr<Tile>> m_OwnedTiles;
+    std::vector<Tile*> m_OwnedTiles;
 };
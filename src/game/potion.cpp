@@ -9,13 +9,8 @@ std::unordered_map<PotionType, PotionData> PotionDataMap = {
 };
 
 Potion::Potion()
-    : m_Type(PotionType::NONE), m_IsApplied(false), m_IterationsLeft(0)
+    : m_Type(PotionType::NONE), m_IsApplied(false), m_IterationsLeft(0), m_Cooldowns()
 {
-    m_Cooldowns[PotionType::HEALING] = 0;
-    m_Cooldowns[PotionType::IMMUNITY] = 0;
-    m_Cooldowns[PotionType::REDUCE_DAMAGE] = 0;
-    m_Cooldowns[PotionType::INCREASE_YIELD] = 0;
-    m_Cooldowns[PotionType::DEAL_DAMAGE] = 0;
 }
 
 bool Potion::Apply(PotionType type)
@@ -26,14 +21,15 @@ bool Potion::Apply(PotionType type)
     m_Type = type;
     m_IsApplied = true;
     m_IterationsLeft = PotionDataMap[type].DurationInIterations;
-    m_Cooldowns[type] = PotionDataMap[type].CooldownInIterations;
+    m_Cooldowns[(size_t)type] = PotionDataMap[type].CooldownInIterations;
     return true;
 }
 
 void Potion::Tick()
 {
     m_IterationsLeft--;
-    m_Cooldowns[m_Type]--;
+    if (m_Type != PotionType::NONE)
+        m_Cooldowns[(size_t)m_Type]--;
     if (m_IterationsLeft <= 0)
         m_IsApplied = false;
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <string>
 #include <unordered_map>
 
@@ -36,13 +37,13 @@ public:
 
     bool Apply(PotionType type);
     void Tick();
-    inline int GetCooldown(PotionType type) { return m_Cooldowns[type]; }
+    inline int GetCooldown(PotionType type) { return m_Cooldowns[(size_t)type]; }
     inline bool IsApplied() const { return m_IsApplied; }
-    inline bool CanApply(PotionType type) { return m_Cooldowns[type] <= 0; }
+    inline bool CanApply(PotionType type) { return m_Cooldowns[(size_t)type] <= 0; }
 
 private:
     PotionType m_Type;
     bool m_IsApplied;
     int m_IterationsLeft;
-    std::unordered_map<PotionType, int> m_Cooldowns;
+    std::array<int, (size_t)PotionType::COUNT> m_Cooldowns;
 };
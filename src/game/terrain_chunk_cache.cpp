@@ -0,0 +1,170 @@
+#include "terrain_chunk_cache.h"
+
+#include <limits>
+
+#include "graphics/renderer.h"
+#include "game/tile.h"
+
+TerrainChunkCache::TerrainChunkCache()
+    : m_ChunkCountX(0), m_ChunkCountY(0), m_MaxChunkSize(0.0f), m_FrameIndex(0), m_Enabled(false)
+{
+    m_ChunkCamera = std::make_shared<OrthographicCamera>(1.0f);
+    m_ChunkCamera->SetScale(1.0f);
+}
+
+void TerrainChunkCache::Update(const std::shared_ptr<GameMap>& gameMap, const std::shared_ptr<OrthographicCamera>& camera,
+                               const TileRange& visibleRange)
+{
+    m_FrameIndex++;
+
+    if (m_GameMap != gameMap)
+        Rebuild(gameMap);
+
+    float pixelsPerUnit = camera->ConvertRelativeSizeToPixel(glm::vec2(1.0f)).y;
+    int zoomBucket = (int)glm::ceil(glm::log2(pixelsPerUnit));
+    float texelsPerUnit = glm::exp2((float)zoomBucket);
+
+    m_Enabled = glm::max(m_MaxChunkSize.x, m_MaxChunkSize.y) * texelsPerUnit <= TERRAIN_CHUNK_MAX_TEXTURE_SIZE;
+    if (!m_Enabled)
+        return;
+
+    // Sized for the largest chunk of the bucket, so every chunk is rendered into its bottom left corner
+    glm::vec2 scratchSize = glm::ceil(m_MaxChunkSize * texelsPerUnit);
+    if (!m_ScratchFramebuffer || m_ScratchFramebuffer->GetWidth() != (unsigned int)scratchSize.x ||
+        m_ScratchFramebuffer->GetHeight() != (unsigned int)scratchSize.y)
+    {
+        m_ScratchFramebuffer = std::make_shared<FrameBuffer>((unsigned int)scratchSize.x, (unsigned int)scratchSize.y, 4);
+    }
+
+    TileRange chunkRange = CalculateChunkRange(visibleRange);
+    int rerenderCount = 0;
+    for (int y = chunkRange.StartY; y < chunkRange.EndY; y++)
+    {
+        for (int x = chunkRange.StartX; x < chunkRange.EndX; x++)
+        {
+            Chunk& chunk = m_Chunks[y * m_ChunkCountX + x];
+            chunk.LastVisibleFrame = m_FrameIndex;
+
+            // Textures of another zoom bucket still cover the right area, so they are only replaced a few per frame
+            bool outdated = chunk.Texture && chunk.ZoomBucket != zoomBucket;
+            if (!chunk.Texture || (outdated && rerenderCount++ < TERRAIN_CHUNK_MAX_RERENDERS_PER_FRAME))
+                Render(chunk, x, y, zoomBucket);
+        }
+    }
+
+    for (auto& chunk : m_Chunks)
+    {
+        if (chunk.Texture && m_FrameIndex - chunk.LastVisibleFrame > TERRAIN_CHUNK_KEEP_FRAMES)
+            chunk.Texture.reset();
+    }
+}
+
+bool TerrainChunkCache::Draw(const TileRange& visibleRange)
+{
+    if (!m_Enabled)
+        return false;
+
+    TileRange chunkRange = CalculateChunkRange(visibleRange);
+    for (int y = chunkRange.StartY; y < chunkRange.EndY; y++)
+    {
+        for (int x = chunkRange.StartX; x < chunkRange.EndX; x++)
+        {
+            const Chunk& chunk = m_Chunks[y * m_ChunkCountX + x];
+            if (chunk.Texture)
+                Renderer2D::DrawQuad(chunk.Position, chunk.Size, chunk.Texture);
+        }
+    }
+
+    return true;
+}
+
+void TerrainChunkCache::Rebuild(const std::shared_ptr<GameMap>& gameMap)
+{
+    m_GameMap = gameMap;
+    m_ChunkCountX = (gameMap->GetTileCountX() + TERRAIN_CHUNK_SIZE - 1) / TERRAIN_CHUNK_SIZE;
+    m_ChunkCountY = (gameMap->GetTileCountY() + TERRAIN_CHUNK_SIZE - 1) / TERRAIN_CHUNK_SIZE;
+    m_MaxChunkSize = glm::vec2(0.0f);
+
+    m_Chunks.clear();
+    m_Chunks.resize(m_ChunkCountX * m_ChunkCountY);
+
+    // Hexes of odd columns are shifted, so chunk bounds are taken from the tiles themselves
+    glm::vec2 halfTileSize = { TILE_WIDTH / 2.0f, TILE_HEIGHT / 2.0f };
+    for (int chunkY = 0; chunkY < m_ChunkCountY; chunkY++)
+    {
+        for (int chunkX = 0; chunkX < m_ChunkCountX; chunkX++)
+        {
+            glm::vec2 min(std::numeric_limits<float>::max());
+            glm::vec2 max(std::numeric_limits<float>::lowest());
+
+            int endY = glm::min((chunkY + 1) * TERRAIN_CHUNK_SIZE, gameMap->GetTileCountY());
+            int endX = glm::min((chunkX + 1) * TERRAIN_CHUNK_SIZE, gameMap->GetTileCountX());
+            for (int y = chunkY * TERRAIN_CHUNK_SIZE; y < endY; y++)
+            {
+                for (int x = chunkX * TERRAIN_CHUNK_SIZE; x < endX; x++)
+                {
+                    glm::vec2 position = gameMap->GetTile(x, y)->GetPosition();
+                    min = glm::min(min, position - halfTileSize);
+                    max = glm::max(max, position + halfTileSize);
+                }
+            }
+
+            Chunk& chunk = m_Chunks[chunkY * m_ChunkCountX + chunkX];
+            chunk.Position = (min + max) / 2.0f;
+            chunk.Size = max - min;
+            m_MaxChunkSize = glm::max(m_MaxChunkSize, chunk.Size);
+        }
+    }
+}
+
+void TerrainChunkCache::Render(Chunk& chunk, int chunkX, int chunkY, int zoomBucket)
+{
+    glm::vec2 pixelSize = glm::ceil(chunk.Size * glm::exp2((float)zoomBucket));
+    if (!chunk.Texture || chunk.ZoomBucket != zoomBucket)
+    {
+        TextureData textureData;
+        textureData.Size = pixelSize;
+        textureData.NrChannels = 4;
+        chunk.Texture = std::make_shared<Texture2D>(textureData);
+        chunk.ZoomBucket = zoomBucket;
+    }
+
+    m_ChunkCamera->SetAspectRatio(chunk.Size.x / chunk.Size.y);
+    m_ChunkCamera->SetZoom(chunk.Size.y / 2.0f);
+    m_ChunkCamera->SetPosition(glm::vec3(chunk.Position, 0.0f));
+
+    Renderer2D::BeginRenderTarget(m_ScratchFramebuffer, glm::uvec2(pixelSize));
+
+    // Gaps between hexes stay transparent, so the ownership glow drawn below the terrain shows through
+    Renderer2D::ClearColor({0.0f, 0.0f, 0.0f, 0.0f});
+
+    // Coverage has to accumulate in the alpha channel instead of being multiplied by it again,
+    // otherwise antialiased edges turn translucent once the texture is blended onto the screen
+    Renderer2D::SetBlendMode(BlendMode::ACCUMULATE_ALPHA);
+
+    Renderer2D::BeginScene(m_ChunkCamera);
+
+    int endY = glm::min((chunkY + 1) * TERRAIN_CHUNK_SIZE, m_GameMap->GetTileCountY());
+    int endX = glm::min((chunkX + 1) * TERRAIN_CHUNK_SIZE, m_GameMap->GetTileCountX());
+    for (int y = chunkY * TERRAIN_CHUNK_SIZE; y < endY; y++)
+    {
+        for (int x = chunkX * TERRAIN_CHUNK_SIZE; x < endX; x++)
+            m_GameMap->GetTile(x, y)->DrawEnvironment(true, true, false);
+    }
+
+    Renderer2D::EndScene();
+
+    Renderer2D::SetBlendMode(BlendMode::ALPHA);
+
+    Renderer2D::EndRenderTarget(chunk.Texture);
+}
+
+TileRange TerrainChunkCache::CalculateChunkRange(const TileRange& visibleRange) const
+{
+    return {
+        visibleRange.StartX / TERRAIN_CHUNK_SIZE,
+        visibleRange.StartY / TERRAIN_CHUNK_SIZE,
+        glm::min((visibleRange.EndX + TERRAIN_CHUNK_SIZE - 1) / TERRAIN_CHUNK_SIZE, m_ChunkCountX),
+        glm::min((visibleRange.EndY + TERRAIN_CHUNK_SIZE - 1) / TERRAIN_CHUNK_SIZE, m_ChunkCountY)
+    };
+}
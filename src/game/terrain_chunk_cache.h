@@ -0,0 +1,60 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "core/camera.h"
+#include "graphics/buffer.h"
+#include "graphics/texture.h"
+#include "game/map.h"
+
+// number of tiles along each side of a terrain chunk
+#define TERRAIN_CHUNK_SIZE 8
+// largest side of a chunk texture in pixels, closer zoom levels draw the terrain directly
+#define TERRAIN_CHUNK_MAX_TEXTURE_SIZE 2048
+// chunks rendered for a previous zoom bucket that are brought up to date per frame
+#define TERRAIN_CHUNK_MAX_RERENDERS_PER_FRAME 4
+// frames after which the texture of a chunk that went out of view is released
+#define TERRAIN_CHUNK_KEEP_FRAMES 300
+
+// Terrain hexes and their decorations do not change during a game, so they are rendered once per chunk of tiles
+// into a texture with the resolution of the current zoom bucket, and panning only draws a few textured quads.
+// Zoom buckets are powers of two of pixels per world unit, so small zoom changes reuse the same textures.
+// All chunks are rendered through one multisampled framebuffer and only keep the resolved texture.
+class TerrainChunkCache
+{
+public:
+    TerrainChunkCache();
+    ~TerrainChunkCache() = default;
+
+    // Renders missing and outdated chunks of the visible range, has to be called outside of a scene
+    void Update(const std::shared_ptr<GameMap>& gameMap, const std::shared_ptr<OrthographicCamera>& camera, const TileRange& visibleRange);
+    // Draws the visible chunks, returns false without drawing when the camera is too close for chunk textures
+    bool Draw(const TileRange& visibleRange);
+
+private:
+    struct Chunk
+    {
+        glm::vec2 Position;
+        glm::vec2 Size;
+        std::shared_ptr<Texture2D> Texture;
+        int ZoomBucket = 0;
+        unsigned int LastVisibleFrame = 0;
+    };
+
+    void Rebuild(const std::shared_ptr<GameMap>& gameMap);
+    void Render(Chunk& chunk, int chunkX, int chunkY, int zoomBucket);
+    TileRange CalculateChunkRange(const TileRange& visibleRange) const;
+
+private:
+    std::vector<Chunk> m_Chunks;
+    int m_ChunkCountX, m_ChunkCountY;
+    glm::vec2 m_MaxChunkSize;
+    std::shared_ptr<GameMap> m_GameMap;
+    std::shared_ptr<OrthographicCamera> m_ChunkCamera;
+    std::shared_ptr<FrameBuffer> m_ScratchFramebuffer;
+    unsigned int m_FrameIndex;
+    bool m_Enabled;
+};
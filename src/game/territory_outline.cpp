@@ -0,0 +1,126 @@
+#include "territory_outline.h"
+
+#include "graphics/renderer.h"
+#include "graphics/render_state.h"
+#include "game/tile.h"
+
+// Neighbour across each edge of Renderer2D::s_HexagonOutline, edge i runs from vertex i to vertex i + 1.
+// Odd columns are shifted half a tile up, so diagonal neighbours depend on the column parity.
+static const glm::ivec2 s_EvenColumnNeighbours[6] = { {-1,  0}, {0, 1}, {1,  0}, {1, -1}, {0, -1}, {-1, -1} };
+static const glm::ivec2 s_OddColumnNeighbours[6]  = { {-1,  1}, {0, 1}, {1,  1}, {1,  0}, {0, -1}, {-1,  0} };
+
+TerritoryOutline::TerritoryOutline()
+    : m_BuiltOwnershipVersion(0)
+{
+}
+
+void TerritoryOutline::Update(const std::shared_ptr<GameMap>& gameMap)
+{
+    if (m_GameMap == gameMap && m_BuiltOwnershipVersion == Tile::s_OwnershipVersion)
+        return;
+
+    // Meshes are keyed by players of the previous game, which are gone once another map is loaded
+    if (m_GameMap != gameMap)
+        m_Meshes.clear();
+
+    m_GameMap = gameMap;
+    Rebuild();
+    m_BuiltOwnershipVersion = Tile::s_OwnershipVersion;
+}
+
+void TerritoryOutline::Draw()
+{
+    for (const auto& [player, mesh] : m_Meshes)
+        Renderer2D::DrawGeometry(mesh.VertexArray, glm::vec3(0.0f), glm::vec2(1.0f), glm::vec4(player->GetColor(), 1.0f));
+}
+
+void TerritoryOutline::Rebuild()
+{
+    for (auto& [player, mesh] : m_Meshes)
+    {
+        mesh.Vertices.clear();
+        mesh.Indices.clear();
+    }
+
+    for (int y = 0; y < m_GameMap->GetTileCountY(); y++)
+    {
+        for (int x = 0; x < m_GameMap->GetTileCountX(); x++)
+        {
+            auto tile = m_GameMap->GetTile(x, y);
+            auto ownedBy = tile->GetOwnedBy();
+            if (!ownedBy)
+                continue;
+
+            const glm::ivec2* neighbours = (x & 1) ? s_OddColumnNeighbours : s_EvenColumnNeighbours;
+            for (int edge = 0; edge < 6; edge++)
+            {
+                if (!IsOwnedBy(x + neighbours[edge].x, y + neighbours[edge].y, ownedBy))
+                    AddEdge(m_Meshes[ownedBy], tile->GetPosition(), edge);
+            }
+        }
+    }
+
+    // Players without territory left may already be destroyed, so neither their key nor their buffers are kept
+    for (auto it = m_Meshes.begin(); it != m_Meshes.end();)
+    {
+        if (it->second.Indices.empty())
+            it = m_Meshes.erase(it);
+        else
+            it++;
+    }
+
+    // Meshes are created before any vertex array gets bound below, creating buffers must not touch its state
+    for (auto& [player, mesh] : m_Meshes)
+    {
+        if (mesh.VertexArray)
+            continue;
+
+        auto vertexBuffer = std::make_shared<VertexBuffer>(nullptr, 0, GL_DYNAMIC_DRAW);
+        auto indexBuffer = std::make_shared<IndexBuffer>(nullptr, 0);
+        std::vector<int> layout = {2};
+        mesh.VertexArray = std::make_shared<VertexArray>(vertexBuffer, indexBuffer, layout);
+    }
+
+    for (auto& [player, mesh] : m_Meshes)
+    {
+        // Element buffer binding is part of the vertex array state
+        mesh.VertexArray->Bind();
+        mesh.VertexArray->GetVertexBuffer()->Bind();
+        mesh.VertexArray->GetVertexBuffer()->SetData(mesh.Vertices.data(), mesh.Vertices.size() * sizeof(float));
+        mesh.VertexArray->GetIndexBuffer()->SetData(mesh.Indices.data(), mesh.Indices.size());
+    }
+    RenderState::BindVertexArray(0);
+}
+
+void TerritoryOutline::AddEdge(Mesh& mesh, const glm::vec2& tilePosition, int edge)
+{
+    const glm::vec2& start = Renderer2D::s_HexagonOutline[edge];
+    const glm::vec2& end = Renderer2D::s_HexagonOutline[(edge + 1) % 6];
+
+    // Inner corners are shared by neighbouring edges of the same tile, so consecutive ribbons meet without gaps
+    glm::vec2 corners[4] = {
+        tilePosition + start,
+        tilePosition + end,
+        tilePosition + end * (1.0f - TERRITORY_OUTLINE_WIDTH),
+        tilePosition + start * (1.0f - TERRITORY_OUTLINE_WIDTH)
+    };
+
+    unsigned int firstVertex = mesh.Vertices.size() / 2;
+    for (const auto& corner : corners)
+    {
+        mesh.Vertices.push_back(corner.x);
+        mesh.Vertices.push_back(corner.y);
+    }
+
+    unsigned int indices[6] = { 0, 1, 2, 0, 2, 3 };
+    for (unsigned int index : indices)
+        mesh.Indices.push_back(firstVertex + index);
+}
+
+bool TerritoryOutline::IsOwnedBy(int x, int y, Player* player)
+{
+    if (x < 0 || y < 0 || x >= m_GameMap->GetTileCountX() || y >= m_GameMap->GetTileCountY())
+        return false;
+
+    return m_GameMap->GetTile(x, y)->GetOwnedBy() == player;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <unordered_map>
+
+#include <glm/glm.hpp>
+
+#include "graphics/vertex_array.h"
+#include "game/map.h"
+#include "game/player.h"
+
+// width of the territory outline relative to the tile radius, matches the border owned tiles used to draw
+#define TERRITORY_OUTLINE_WIDTH 0.03f
+
+// Outline around the territory of every player. Only hexagon edges between tiles of different owners are kept,
+// each becoming a ribbon inset into the owned tile, and all ribbons of a player share one mesh drawn in a single call.
+// Meshes are only rebuilt when the ownership of a tile changes.
+class TerritoryOutline
+{
+public:
+    TerritoryOutline();
+    ~TerritoryOutline() = default;
+
+    void Update(const std::shared_ptr<GameMap>& gameMap);
+    void Draw();
+
+private:
+    struct Mesh
+    {
+        std::shared_ptr<VertexArray> VertexArray;
+        std::vector<float> Vertices;
+        std::vector<unsigned int> Indices;
+    };
+
+    void Rebuild();
+    void AddEdge(Mesh& mesh, const glm::vec2& tilePosition, int edge);
+    bool IsOwnedBy(int x, int y, Player* player);
+
+private:
+    std::shared_ptr<GameMap> m_GameMap;
+    unsigned int m_BuiltOwnershipVersion;
+    std::unordered_map<Player*, Mesh> m_Meshes;
+};
@@ -7,6 +7,7 @@
 #include "core/logger.h"
 #include "core/resource_manager.h"
 #include "graphics/renderer.h"
+#include "graphics/hexagon_instances.h"
 #include "debug/debug_data.h"
 #include "game/player.h"
 #include "util/util.h"
@@ -14,8 +15,6 @@
 #include "game/battle.h"
 #include "widgets/notification.h"
 
-#include <GLFW/glfw3.h>
-
 float Tile::s_BackgroundHeightRatio = 0.8f;
 
 int Tile::s_UnitGroupRows = 3;
@@ -33,6 +32,11 @@ const std::vector<glm::ivec2> Tile::s_AdjacentTileOffsets = {
               {-1, 0}, {0, -1}, {1, 0}
 };
 
+unsigned int Tile::s_OwnershipVersion = 0;
+unsigned int Tile::s_StateVersion = 0;
+// starts above the version of a new render cache, so every tile calculates its layout once
+unsigned int Tile::s_LayoutVersion = 1;
+
 std::shared_ptr<Texture2D> Tile::s_UpgradeIconTexture;
 
 std::unordered_map<TileEnvironment, Resources> EnvironmentResourcesMap = {
@@ -44,10 +48,9 @@ std::unordered_map<TileEnvironment, Resources> EnvironmentResourcesMap = {
 };
 
 Tile::Tile(TileEnvironment environment, const glm::ivec2& coords)
-    : m_Environment(environment), m_Coords(coords), m_Position(Tile::CalculateTilePosition(coords.x, coords.y))
+    : m_Environment(environment), m_Coords(coords), m_Position(Tile::CalculateTilePosition(coords.x, coords.y)), m_OwnedBy(nullptr)
 {
     m_Resources = EnvironmentResourcesMap[m_Environment];
-    m_Potion = std::make_shared<Potion>();
     InitStaticRuntimeData();
 }
 
@@ -58,8 +61,10 @@ void Tile::InitStaticRuntimeData()
 
 Tile::~Tile()
 {
-    for (auto unit : m_UnitGroups)
-        delete unit;
+    for (auto unitGroup : m_UnitGroups)
+        UnitGroupPool.Destroy(unitGroup);
+    for (auto building : m_Buildings)
+        BuildingPool.Destroy(building);
 }
 
 void Tile::CreateUnitGroup(UnitGroupType type)
@@ -84,19 +89,22 @@ void Tile::CreateUnitGroup(UnitGroupType type)
 
         if (maxRequiredBuildingLevel > 0)
         {
-            UnitStats* upgradedUnitStats = new UnitStats(UnitGroupDataMap[type].Stats + maxRequiredBuildingLevel);
-            m_UnitGroups.emplace_back(new UnitGroup(type, upgradedUnitStats, GameLayer::Get().GetIteration()));
+            UnitStats upgradedUnitStats = UnitGroupDataMap[type].Stats + maxRequiredBuildingLevel;
+            m_UnitGroups.emplace_back(UnitGroupPool.Create(type, upgradedUnitStats, GameLayer::Get().GetIteration()));
         }
         else
         {
-            m_UnitGroups.emplace_back(new UnitGroup(type, std::nullopt, GameLayer::Get().GetIteration()));
+            m_UnitGroups.emplace_back(UnitGroupPool.Create(type, std::nullopt, GameLayer::Get().GetIteration()));
         }
+
+        s_StateVersion++;
+        InvalidateRenderCache();
     }
     else
         LOG_WARN("Trying to add unit group of type '{0}' to non-existent tile", UnitGroupDataMap[type].TextureName);
 }
 
-void Tile::CreateUnitGroup(UnitGroup unitGroup)
+void Tile::CreateUnitGroup(const UnitGroup& unitGroup)
 {
     if (!HasSpaceForUnitGroups(1))
     {
@@ -106,12 +114,30 @@ void Tile::CreateUnitGroup(UnitGroup unitGroup)
     }
 
     if (AssetsCanExist())
-        m_UnitGroups.emplace_back(new UnitGroup(unitGroup));
+    {
+        m_UnitGroups.emplace_back(UnitGroupPool.Create(unitGroup));
+        s_StateVersion++;
+        InvalidateRenderCache();
+    }
     else
         LOG_WARN("Trying to add unit group object of type '{0}' to non-existent tile",
                  UnitGroupDataMap[unitGroup.GetType()].TextureName);
 }
 
+void Tile::DestroyUnitGroups(const std::function<bool(UnitGroup*)>& condition)
+{
+    size_t kept = 0;
+    for (size_t i = 0; i < m_UnitGroups.size(); i++)
+    {
+        if (condition(m_UnitGroups[i]))
+            UnitGroupPool.Destroy(m_UnitGroups[i]);
+        else
+            m_UnitGroups[kept++] = m_UnitGroups[i];
+    }
+
+    m_UnitGroups.resize(kept);
+}
+
 bool Tile::CanRecruitUnitGroup(UnitGroupType type)
 {
     if (type == UnitGroupType::NONE || type == UnitGroupType::COUNT)
@@ -152,12 +178,15 @@ void Tile::CreateBuilding(BuildingType type)
     }
 
     if (AssetsCanExist())
-        m_Buildings.emplace_back(new Building(type));
+    {
+        m_Buildings.emplace_back(BuildingPool.Create(type));
+        InvalidateRenderCache();
+    }
     else
         LOG_WARN("Trying to add building of type '{0}' to non-existent tile", BuildingDataMap[type].TextureName);
 }
 
-void Tile::CreateBuilding(Building building)
+void Tile::CreateBuilding(const Building& building)
 {
     if (!HasSpaceForBuildings(1))
     {
@@ -167,73 +196,58 @@ void Tile::CreateBuilding(Building building)
     }
 
     if (AssetsCanExist())
-        m_Buildings.emplace_back(new Building(building));
+    {
+        m_Buildings.emplace_back(BuildingPool.Create(building));
+        InvalidateRenderCache();
+    }
     else
         LOG_WARN("Trying to add building of type '{0}' to non-existent tile",
                  BuildingDataMap[building.GetType()].TextureName);
 }
 
-void Tile::Draw()
+void Tile::Draw(TileDetail detail, bool drawDecoration)
 {
-    auto camera = GameLayer::Get().GetCameraController()->GetCamera();
-    auto relBtmLeft = glm::vec2(
-        m_Position.x - TILE_WIDTH / 4.0f,
-        m_Position.y - TILE_HEIGHT / 4.0f
-    ) - camera->CalculateRelativeBottomLeftPosition();
-    auto pxBtmLeft = camera->ConvertRelativeSizeToPixel(relBtmLeft);
-    auto pxSize = camera->ConvertRelativeSizeToPixel({TILE_WIDTH, TILE_HEIGHT});
-
-    static auto hueShader = ResourceManager::GetShader("hue");
-    auto hueShaderData = ShaderData();
-    hueShaderData.UniformMap["u_BottomLeftPx"] = pxBtmLeft;
-    hueShaderData.UniformMap["u_SizePx"] = pxSize;
-
-    if (m_OwnedBy)
-    {
-        static float t = 1.3f;
-        hueShaderData.UniformMap["u_Color"] = m_OwnedBy->GetColor();
-        hueShaderData.UniformMap["u_Time"] = t;
-
-        if (m_OwnedBy == GameLayer::Get().GetPlayerManager()->GetCurrentPlayer())
-        {
-            int iteration = GameLayer::Get().GetIteration();
-            bool hasNotMovedUnits = false;
-            for (auto ug : m_UnitGroups)
-            {
-                if (ug->GetMovedOnIteration() != iteration)
-                {
-                    hasNotMovedUnits = true;
-                    break;
-                }
-            }
-
-            if (hasNotMovedUnits)
-                hueShaderData.UniformMap["u_Time"] = (float)glfwGetTime();
-        }
+    // Terrain fill and the ocean are drawn by the game layer, together with the decorations while they are cached in terrain chunks
+    Renderer2D::SetLayer(RenderLayer::ENVIRONMENT);
+    DrawEnvironment(false, drawDecoration && detail != TileDetail::COLOR, false);
 
-        Renderer2D::DrawHexagon(m_Position, glm::vec2(2.0f), hueShader, hueShaderData);
+    Renderer2D::SetLayer(RenderLayer::OBJECTS);
+    if (detail == TileDetail::AGGREGATED)
+    {
+        DrawArmyStrength();
+    }
+    else if (detail != TileDetail::COLOR)
+    {
+        DrawUnitGroups(detail == TileDetail::FULL);
+        DrawBuildings(detail == TileDetail::FULL);
     }
 
-    DrawEnvironment(camera);
-    DrawUnitGroups();
-    DrawBuildings();
-
-    if (m_OwnedBy)
-        Renderer2D::DrawHexagon(m_Position, glm::vec2(1.0f), glm::vec4(m_OwnedBy->GetColor(), 1.0f), 3.0f);
-
-    if (m_Potion->IsApplied())
+    // Potion effects themselves are drawn for all tiles at once by TileEffects
+    if (m_Potion.IsApplied() && detail == TileDetail::FULL)
     {
-        DrawPotionEffect();
+        Renderer2D::SetLayer(RenderLayer::OVERLAY);
+        DrawPotionLabel();
     }
 
-    if (GameLayer::Get().IsEarnedResourcesInfoVisible() &&
-        GameLayer::Get().GetPlayerManager()->GetCurrentPlayer() == m_OwnedBy)
+    if (detail == TileDetail::FULL &&
+        GameLayer::Get().IsEarnedResourcesInfoVisible() &&
+        GameLayer::Get().GetPlayerManager()->GetCurrentPlayer().get() == m_OwnedBy)
     {
+        Renderer2D::SetLayer(RenderLayer::OVERLAY);
         DrawEarnedResourcesInfoOverlay();
     }
 }
 
-DrawData Tile::GetUnitGroupDrawData()
+ShaderParams Tile::GetEffectShaderParams(const glm::vec4& color) const
+{
+    ShaderParams params;
+    params.Color = color;
+    params.EffectPosition = { m_Position.x - TILE_WIDTH / 4.0f, m_Position.y - TILE_HEIGHT / 4.0f };
+    params.EffectSize = { TILE_WIDTH, TILE_HEIGHT };
+    return params;
+}
+
+DrawData Tile::CalculateUnitGroupDrawData() const
 {
     float L = TILE_WIDTH / 2 * s_BackgroundHeightRatio;
     float dx = glm::cos(glm::radians(60.0f)) * L;
@@ -260,7 +274,7 @@ DrawData Tile::GetUnitGroupDrawData()
     };
 }
 
-DrawData Tile::GetBuildingDrawData()
+DrawData Tile::CalculateBuildingDrawData() const
 {
     float L = TILE_WIDTH / 2 * 0.4;
     float dx = glm::cos(glm::radians(60.0f)) * L;
@@ -287,16 +301,96 @@ DrawData Tile::GetBuildingDrawData()
     };
 }
 
-void Tile::DrawUnitGroups()
+std::vector<glm::vec2> Tile::CalculateSlots(const DrawData& data, int count, int perRow)
 {
-    if (m_UnitGroups.empty()) return;
+    std::vector<glm::vec2> slots;
+    slots.reserve(count);
 
-    auto unitData = GetUnitGroupDrawData();
-    float initialX = unitData.Position.x;
-    bool isCurrentPlayer = GameLayer::Get().GetPlayerManager()->GetCurrentPlayer() == m_OwnedBy;
+    glm::vec2 position = data.Position;
+    for (int i = 0; i < count; i++)
+    {
+        slots.push_back(position);
+
+        if ((i + 1) % perRow == 0)
+        {
+            position.x = data.Position.x;
+            position.y -= (data.OffsetSize.y + data.Size.y);
+        }
+        else
+        {
+            position.x += data.Size.x + data.OffsetSize.x;
+        }
+    }
+
+    return slots;
+}
 
-    int totalStats[s_StatCount] = { 0, 0, 0 };
-    int selectedStats[s_StatCount] = { 0, 0, 0 };
+const TileRenderCache& Tile::UpdateRenderCache()
+{
+    if (!m_RenderCache)
+        m_RenderCache = std::make_unique<TileRenderCache>();
+
+    if (m_RenderCache->LayoutVersion != s_LayoutVersion)
+    {
+        m_RenderCache->UnitGroupData = CalculateUnitGroupDrawData();
+        m_RenderCache->BuildingData = CalculateBuildingDrawData();
+        m_RenderCache->LayoutVersion = s_LayoutVersion;
+        m_RenderCache->Dirty = true;
+    }
+
+    bool labelsForOwner = GameLayer::Get().GetPlayerManager()->GetCurrentPlayer().get() == m_OwnedBy;
+    if (!m_RenderCache->Dirty && m_RenderCache->LabelsForOwner == labelsForOwner)
+        return *m_RenderCache;
+
+    if (m_RenderCache->Dirty)
+    {
+        m_RenderCache->UnitGroupSlots = CalculateSlots(m_RenderCache->UnitGroupData, m_UnitGroups.size(), s_UnitGroupsPerRow);
+        m_RenderCache->BuildingSlots = CalculateSlots(m_RenderCache->BuildingData, m_Buildings.size(), s_BuildingsPerRow);
+
+        m_RenderCache->TotalStats = {};
+        m_RenderCache->SelectedStats = {};
+        for (auto unitGroup : m_UnitGroups)
+        {
+            for (auto unitStats : unitGroup->GetUnitStats())
+            {
+                m_RenderCache->TotalStats = m_RenderCache->TotalStats + *unitStats;
+                if (unitGroup->IsSelected())
+                    m_RenderCache->SelectedStats = m_RenderCache->SelectedStats + *unitStats;
+            }
+        }
+
+        m_RenderCache->BuildingLabels.clear();
+        for (auto building : m_Buildings)
+            m_RenderCache->BuildingLabels.push_back("lvl " + std::to_string(building->GetLevel()));
+    }
+
+    const UnitStats& total = m_RenderCache->TotalStats;
+    const UnitStats& selected = m_RenderCache->SelectedStats;
+    int totalStats[s_StatCount] = { total.Attack, total.Defense, total.Health };
+    int selectedStats[s_StatCount] = { selected.Attack, selected.Defense, selected.Health };
+
+    m_RenderCache->StatLabels.resize(s_StatCount);
+    for (int i = 0; i < s_StatCount; i++)
+    {
+        m_RenderCache->StatLabels[i] =
+            labelsForOwner ?
+            std::to_string(selectedStats[i]) + " / " + std::to_string(totalStats[i]) :
+            std::to_string(totalStats[i]);
+    }
+
+    m_RenderCache->LabelsForOwner = labelsForOwner;
+    m_RenderCache->Dirty = false;
+    return *m_RenderCache;
+}
+
+void Tile::DrawUnitGroups(bool drawText)
+{
+    if (m_UnitGroups.empty()) return;
+
+    const auto& cache = UpdateRenderCache();
+    const auto& unitData = cache.UnitGroupData;
+    bool isCurrentPlayer = cache.LabelsForOwner;
+    unsigned int iteration = GameLayer::Get().GetIteration();
 
     Renderer2D::DrawQuad(
         unitData.BackgroundPosition,
@@ -306,64 +400,60 @@ void Tile::DrawUnitGroups()
 
     for (int i = 0; i < m_UnitGroups.size(); i++)
     {
-        auto unitStatsVector = m_UnitGroups[i]->GetUnitStats();
+        const glm::vec2& slot = cache.UnitGroupSlots[i];
 
         if (m_UnitGroups[i]->IsSelected())
         {
             Renderer2D::DrawQuad(
-                unitData.Position,
+                slot,
                 unitData.Size,
                 {0.8f, 0.1f, 0.1f, 0.6f}
             );
-
-            for (auto unitStats : unitStatsVector)
-            {
-                selectedStats[0] += unitStats->Attack;
-                selectedStats[1] += unitStats->Defense;
-                selectedStats[2] += unitStats->Health;
-
-                totalStats[0] += unitStats->Attack;
-                totalStats[1] += unitStats->Defense;
-                totalStats[2] += unitStats->Health;
-            }
-        }
-        else
-        {
-            for (auto unitStats : unitStatsVector)
-            {
-                totalStats[0] += unitStats->Attack;
-                totalStats[1] += unitStats->Defense;
-                totalStats[2] += unitStats->Health;
-            }
         }
 
         Renderer2D::DrawQuad(
-            unitData.Position,
+            slot,
             unitData.Size,
             ResourceManager::GetTexture(UnitGroupDataMap[m_UnitGroups[i]->GetType()].TextureName)
         );
 
-        if (m_UnitGroups[i]->UnitWasMovedInIteration(GameLayer::Get().GetIteration()) && isCurrentPlayer)
+        if (m_UnitGroups[i]->UnitWasMovedInIteration(iteration) && isCurrentPlayer)
         {
             Renderer2D::DrawQuad(
-                unitData.Position,
+                slot,
                 unitData.Size,
                 {0.2f, 0.2f, 0.2f, 0.5f}
             );
         }
-
-        if ((i + 1) % s_UnitGroupsPerRow == 0)
-        {
-            unitData.Position.x = initialX;
-            unitData.Position.y -= (unitData.OffsetSize.y + unitData.Size.y);
-        }
-        else
-        {
-            unitData.Position.x += unitData.Size.x + unitData.OffsetSize.x;
-        }
     }
 
-    DrawCountedStats(unitData, totalStats, selectedStats);
+    if (drawText)
+        DrawCountedStats();
+}
+
+void Tile::DrawArmyStrength()
+{
+    if (m_UnitGroups.empty()) return;
+
+    const auto& cache = UpdateRenderCache();
+    const auto& unitData = cache.UnitGroupData;
+    int strength = cache.TotalStats.Attack + cache.TotalStats.Defense + cache.TotalStats.Health;
+
+    Renderer2D::DrawQuad(
+        unitData.BackgroundPosition,
+        unitData.BackgroundSize,
+        ColorData::Get().TileColors.AssetBackgroundColor
+    );
+
+    // One glyph growing with the whole army replaces the icons of every unit group
+    float strengthRatio = glm::min(strength / TILE_DETAIL_GLYPH_MAX_STRENGTH, 1.0f);
+    float glyphSize = unitData.BackgroundSize.y * (0.4f + 0.6f * strengthRatio);
+
+    Renderer2D::DrawQuad(
+        unitData.BackgroundPosition,
+        glm::vec2(glyphSize),
+        ResourceManager::GetTexture("swords")
+    );
 }
 
 void Tile::DrawUnitGroupStats(DrawData& unitData, UnitGroup* unitGroup)
@@ -421,29 +511,24 @@ void Tile::DrawUnitGroupStats(DrawData& unitData, UnitGroup* unitGroup)
     }
 }
 
-void Tile::DrawCountedStats(DrawData& unitData, int totalStats[], int selectedStats[])
+void Tile::DrawCountedStats()
 {
     static float yOffset = TILE_HEIGHT / 2.0f - 0.45f;
     static float statSize = 0.10f;
     static float textScale = 0.30f;
 
-    auto currPlayer = GameLayer::Get().GetPlayerManager()->GetCurrentPlayer();
+    const auto& statLabels = m_RenderCache->StatLabels;
 
     glm::vec2 statPos = {m_Position.x - 0.45f, m_Position.y - yOffset};
     for (int i = 0; i < s_StatCount; i++)
     {
-        std::string statText =
-            m_OwnedBy == currPlayer ?
-            std::to_string(selectedStats[i]) + " / " + std::to_string(totalStats[i]) :
-            std::to_string(totalStats[i]);
-
         Renderer2D::DrawQuad(
             glm::vec2(statPos.x, statPos.y - statSize),
             glm::vec2(statSize),
             ResourceManager::GetTexture(s_StatTextures[i])
         );
         Renderer2D::DrawTextStr(
-            statText,
+            statLabels[i],
             { statPos.x, statPos.y },
             textScale / GameLayer::Get().GetCameraController()->GetCamera()->GetZoom(),
             glm::vec3(1.0f), HTextAlign::MIDDLE, VTextAlign::MIDDLE, "rexlia"
@@ -454,43 +539,35 @@ void Tile::DrawCountedStats(DrawData& unitData, int totalStats[], int selectedSt
 
 void Tile::CheckUnitGroupHover(const glm::vec2& relMousePos)
 {
-    auto unitData = GetUnitGroupDrawData();
-    float initialX = unitData.Position.x;
+    const auto& cache = UpdateRenderCache();
+    auto unitData = cache.UnitGroupData;
 
     for (int i = 0; i < m_UnitGroups.size(); i++)
     {
-        if (Util::IsPointInRectangle(unitData.Position, unitData.Size, relMousePos))
+        if (Util::IsPointInRectangle(cache.UnitGroupSlots[i], unitData.Size, relMousePos))
         {
+            unitData.Position = cache.UnitGroupSlots[i];
             DrawUnitGroupStats(unitData, m_UnitGroups[i]);
             return;
         }
-
-        if ((i + 1) % s_UnitGroupsPerRow == 0)
-        {
-            unitData.Position.x = initialX;
-            unitData.Position.y -= (unitData.OffsetSize.y + unitData.Size.y);
-        }
-        else
-        {
-            unitData.Position.x += unitData.Size.x + unitData.OffsetSize.x;
-        }
     }
 }
 
 void Tile::CheckBuildingHover(const glm::vec2& relMousePos)
 {
-    if (GameLayer::Get().GetPlayerManager()->GetCurrentPlayer() != m_OwnedBy) return;
+    if (GameLayer::Get().GetPlayerManager()->GetCurrentPlayer().get() != m_OwnedBy) return;
 
-    auto buildingData = GetBuildingDrawData();
-    float initialX = buildingData.Position.x;
+    const auto& cache = UpdateRenderCache();
+    const auto& buildingData = cache.BuildingData;
     static glm::vec2 upgradeIconSize = buildingData.Size * 0.3f;
     bool hoveredOverUpgradeIcon = false;
 
     for (int i = 0; i < m_Buildings.size(); i++)
     {
-        glm::vec2 upgradeIconPosition = buildingData.Position + buildingData.Size / 2.0f - upgradeIconSize / 2.0f;
+        const glm::vec2& slot = cache.BuildingSlots[i];
+        glm::vec2 upgradeIconPosition = slot + buildingData.Size / 2.0f - upgradeIconSize / 2.0f;
 
-        if (Util::IsPointInRectangle(buildingData.Position, buildingData.Size, relMousePos))
+        if (Util::IsPointInRectangle(slot, buildingData.Size, relMousePos))
         {
             // Upgrade icon
             Renderer2D::DrawQuad(
@@ -508,20 +585,10 @@ void Tile::CheckBuildingHover(const glm::vec2& relMousePos)
                     s_UpgradeIconTexture
                 );
 
-                GameLayer::Get().SetBuildingUpgradeInfo({ true, m_Buildings[i] });
+                GameLayer::Get().SetBuildingUpgradeInfo({ true, BuildingPool.GetHandle(m_Buildings[i]) });
                 hoveredOverUpgradeIcon = true;
             }
         }
-
-        if ((i + 1) % s_BuildingsPerRow == 0)
-        {
-            buildingData.Position.x = initialX;
-            buildingData.Position.y -= (buildingData.OffsetSize.y + buildingData.Size.y);
-        }
-        else
-        {
-            buildingData.Position.x += buildingData.Size.x + buildingData.OffsetSize.x;
-        }
     }
 
     if (!hoveredOverUpgradeIcon)
@@ -535,14 +602,16 @@ void Tile::SelectAllUnitGroups()
         if (!unitGroup->UnitWasMovedInIteration(GameLayer::Get().GetIteration()))
             unitGroup->SetSelected(true);
     }
+
+    InvalidateRenderCache();
 }
 
-void Tile::DrawBuildings()
+void Tile::DrawBuildings(bool drawText)
 {
     if (m_Buildings.empty()) return;
 
-    auto buildingData = GetBuildingDrawData();
-    float initialX = buildingData.Position.x;
+    const auto& cache = UpdateRenderCache();
+    const auto& buildingData = cache.BuildingData;
     auto camera = GameLayer::Get().GetCameraController()->GetCamera();
 
     Renderer2D::DrawQuad(
@@ -555,40 +624,33 @@ void Tile::DrawBuildings()
     {
         // Building texture
         Renderer2D::DrawQuad(
-            buildingData.Position,
+            cache.BuildingSlots[i],
             buildingData.Size,
             ResourceManager::GetTexture(BuildingDataMap[m_Buildings[i]->GetType()].TextureName)
         );
 
         // Level number
         // TODO(Viktor): Remove once having separater textures for different building levels
-        Renderer2D::DrawTextStr(
-            "lvl " + std::to_string(m_Buildings[i]->GetLevel()),
-            buildingData.Position - buildingData.Size / 2.0f,
-            0.3f / camera->GetZoom(),
-            glm::vec3(1.0f),
-            HTextAlign::LEFT,
-            VTextAlign::BOTTOM,
-            "rexlia"
-        );
-
-        if ((i + 1) % s_BuildingsPerRow == 0)
-        {
-            buildingData.Position.x = initialX;
-            buildingData.Position.y -= (buildingData.OffsetSize.y + buildingData.Size.y);
-        }
-        else
+        if (drawText)
         {
-            buildingData.Position.x += buildingData.Size.x + buildingData.OffsetSize.x;
+            Renderer2D::DrawTextStr(
+                cache.BuildingLabels[i],
+                cache.BuildingSlots[i] - buildingData.Size / 2.0f,
+                0.3f / camera->GetZoom(),
+                glm::vec3(1.0f),
+                HTextAlign::LEFT,
+                VTextAlign::BOTTOM,
+                "rexlia"
+            );
         }
     }
 }
 
 void Tile::TickPotion()
 {
-    if (m_Potion->IsApplied())
+    if (m_Potion.IsApplied())
     {
-        switch (m_Potion->GetType())
+        switch (m_Potion.GetType())
         {
             case PotionType::HEALING:
             {
@@ -608,11 +670,9 @@ void Tile::TickPotion()
                     stats->Health = stats->Health + (-1);
                 }
 
-                Util::RemoveElementsFromContainerWithCondition<std::vector<UnitGroup*>, UnitGroup*>(
-                    m_UnitGroups, [](UnitGroup* ug) {
-                        return ug->GetUnitStats()[0]->Health <= 0;
-                    }
-                );
+                DestroyUnitGroups([](UnitGroup* ug) {
+                    return ug->GetUnitStats()[0]->Health <= 0;
+                });
                 break;
             }
             default:
@@ -620,65 +680,17 @@ void Tile::TickPotion()
         };
     }
 
-    m_Potion->Tick();
+    m_Potion.Tick();
+    s_StateVersion++;
+    InvalidateRenderCache();
 }
 
-void Tile::DrawPotionEffect()
+void Tile::DrawPotionLabel()
 {
     auto camera = GameLayer::Get().GetCameraController()->GetCamera();
-    auto relBtmLeft = glm::vec2(
-        m_Position.x - TILE_WIDTH / 4.0f,
-        m_Position.y - TILE_HEIGHT / 4.0f
-    ) - camera->CalculateRelativeBottomLeftPosition();
-    auto pxBtmLeft = camera->ConvertRelativeSizeToPixel(relBtmLeft);
-    auto pxSize = camera->ConvertRelativeSizeToPixel({TILE_WIDTH, TILE_HEIGHT});
-
-    static auto potionShader = ResourceManager::GetShader("potion");
-    ShaderData potionShaderData{};
-    potionShaderData.UniformMap["u_Time"] = (float)glfwGetTime();
-    potionShaderData.UniformMap["u_BottomLeftPx"] = pxBtmLeft;
-    potionShaderData.UniformMap["u_SizePx"] = pxSize;
-
-    glm::vec3 effectColor = glm::vec3(1.0f);
-    switch (m_Potion->GetType())
-    {
-        case PotionType::HEALING:
-        {
-            effectColor = glm::vec3(0.95f, 0.3f, 0.2f);
-            break;
-        }
-        case PotionType::IMMUNITY:
-        {
-            effectColor = glm::vec3(0.25f, 0.6f, 0.95f);
-            break;
-        }
-        case PotionType::REDUCE_DAMAGE:
-        {
-            effectColor = glm::vec3(0.25f, 0.9f, 0.2f);
-            break;
-        }
-        case PotionType::INCREASE_YIELD:
-        {
-            effectColor = glm::vec3(0.9f, 0.9f, 0.2f);
-            break;
-        }
-        case PotionType::DEAL_DAMAGE:
-        {
-            effectColor = glm::vec3(0.1f, 0.1f, 0.1f);
-            break;
-        }
-        default:
-        {
-            LOG_WARN("Tile: Unknow potion type");
-            return;
-        }
-    }
-
-    potionShaderData.UniformMap["u_Color"] = effectColor;
-    Renderer2D::DrawHexagon(m_Position, glm::vec2(1.0f), potionShader, potionShaderData);
 
     Renderer2D::DrawTextStr(
-        Util::ReplaceChar(PotionDataMap[m_Potion->GetType()].TextureName, '_', ' '),
+        Util::ReplaceChar(PotionDataMap[m_Potion.GetType()].TextureName, '_', ' '),
         {
             m_Position.x,
             m_Position.y + TILE_HEIGHT / 2.0f - 0.07f
@@ -735,7 +747,32 @@ void Tile::DrawEarnedResourcesInfoOverlay()
     }
 }
 
-void Tile::DrawEnvironment(const std::shared_ptr<OrthographicCamera>& camera)
+void Tile::SubmitTerrain(const std::shared_ptr<HexagonInstances>& instances) const
+{
+    static auto tileColors = ColorData::Get().TileColors;
+    switch (m_Environment)
+    {
+        case TileEnvironment::FOREST:
+            instances->Add(m_Position, glm::vec2(1.0f), { tileColors.ForestColor, 1.0f });
+            break;
+        case TileEnvironment::DESERT:
+            instances->Add(m_Position, glm::vec2(1.0f), { tileColors.DesertColor, 1.0f });
+            break;
+        case TileEnvironment::MOUNTAINS:
+            instances->Add(m_Position, glm::vec2(1.0f), { tileColors.MountainsColor, 1.0f });
+            break;
+        case TileEnvironment::HIGHLIGHT:
+            instances->Add(m_Position, glm::vec2(1.0f), { 0.5f, 0.5f, 0.5f, 1.0f }, 5.0f);
+            break;
+        case TileEnvironment::NONE:
+        case TileEnvironment::OCEAN:
+            break;
+        default:
+            instances->Add(m_Position, glm::vec2(1.0f), { 1.0f, 0.0f, 1.0f, 1.0f });
+    }
+}
+
+void Tile::DrawEnvironment(bool drawTerrain, bool drawDecoration, bool drawWater)
 {
     if (m_Environment != TileEnvironment::NONE)
     {
@@ -746,48 +783,45 @@ void Tile::DrawEnvironment(const std::shared_ptr<OrthographicCamera>& camera)
         {
             case TileEnvironment::OCEAN:
             {
-                auto relBtmLeft = glm::vec2(
-                    m_Position.x - TILE_WIDTH / 4.0f,
-                    m_Position.y - TILE_HEIGHT / 4.0f
-                ) - camera->CalculateRelativeBottomLeftPosition();
-                auto pxBtmLeft = camera->ConvertRelativeSizeToPixel(relBtmLeft);
-                auto pxSize = camera->ConvertRelativeSizeToPixel({TILE_WIDTH, TILE_HEIGHT});
-
                 static auto waterShader = ResourceManager::GetShader("water");
-                auto waterShaderData = ShaderData();
-                waterShaderData.UniformMap["u_Time"] = (float)glfwGetTime();
-                waterShaderData.UniformMap["u_BottomLeftPx"] = pxBtmLeft;
-                waterShaderData.UniformMap["u_SizePx"] = pxSize;
-
-                Renderer2D::DrawHexagon(m_Position, glm::vec2(1.0f), waterShader, waterShaderData);
+                if (drawWater)
+                    Renderer2D::DrawHexagon(m_Position, glm::vec2(1.0f), waterShader, GetEffectShaderParams());
                 return;
             }
             case TileEnvironment::FOREST:
             {
-                Renderer2D::DrawHexagon(m_Position, glm::vec2(1.0f), { tileColors.ForestColor, 1.0f });
-                Renderer2D::DrawQuad({m_Position.x, m_Position.y - yOffset}, glm::vec2(0.2f), ResourceManager::GetTexture("tree"));
+                if (drawTerrain)
+                    Renderer2D::DrawHexagon(m_Position, glm::vec2(1.0f), { tileColors.ForestColor, 1.0f });
+                if (drawDecoration)
+                    Renderer2D::DrawQuad({m_Position.x, m_Position.y - yOffset}, glm::vec2(0.2f), ResourceManager::GetTexture("tree"));
                 break;
             }
             case TileEnvironment::DESERT:
             {
-                Renderer2D::DrawHexagon(m_Position, glm::vec2(1.0f), { tileColors.DesertColor, 1.0f });
-                Renderer2D::DrawQuad({m_Position.x, m_Position.y - yOffset}, glm::vec2(0.2f), ResourceManager::GetTexture("sand"));
+                if (drawTerrain)
+                    Renderer2D::DrawHexagon(m_Position, glm::vec2(1.0f), { tileColors.DesertColor, 1.0f });
+                if (drawDecoration)
+                    Renderer2D::DrawQuad({m_Position.x, m_Position.y - yOffset}, glm::vec2(0.2f), ResourceManager::GetTexture("sand"));
                 break;
             }
             case TileEnvironment::MOUNTAINS:
             {
-                Renderer2D::DrawHexagon(m_Position, glm::vec2(1.0f), { tileColors.MountainsColor, 1.0f });
-                Renderer2D::DrawQuad({m_Position.x, m_Position.y - yOffset}, glm::vec2(0.2f), ResourceManager::GetTexture("stone"));
+                if (drawTerrain)
+                    Renderer2D::DrawHexagon(m_Position, glm::vec2(1.0f), { tileColors.MountainsColor, 1.0f });
+                if (drawDecoration)
+                    Renderer2D::DrawQuad({m_Position.x, m_Position.y - yOffset}, glm::vec2(0.2f), ResourceManager::GetTexture("stone"));
                 break;
             }
             case TileEnvironment::HIGHLIGHT:
             {
-                Renderer2D::DrawHexagon(m_Position, glm::vec2(1.0f), { 0.5f, 0.5f, 0.5f, 1.0f }, 5.0f);
+                if (drawTerrain)
+                    Renderer2D::DrawHexagon(m_Position, glm::vec2(1.0f), { 0.5f, 0.5f, 0.5f, 1.0f }, 5.0f);
                 break;
             }
             default:
             {
-                Renderer2D::DrawHexagon(m_Position, glm::vec2(1.0f), { 1.0f, 0.0f, 1.0f, 1.0f });
+                if (drawTerrain)
+                    Renderer2D::DrawHexagon(m_Position, glm::vec2(1.0f), { 1.0f, 0.0f, 1.0f, 1.0f });
             }
         }
     }
@@ -806,7 +840,7 @@ const Resources Tile::GetResources() const
             extraGold += building->GetLevel() * 2 + 2;
     }
 
-    if (m_Potion->IsApplied() && m_Potion->GetType() == PotionType::INCREASE_YIELD)
+    if (m_Potion.IsApplied() && m_Potion.GetType() == PotionType::INCREASE_YIELD)
     {
         extraWood = (int)(m_Resources.Wood / 2.0f + 0.5f);
         extraRock = (int)(m_Resources.Rock / 2.0f + 0.5f);
@@ -841,47 +875,54 @@ UnitStats Tile::GetTotalUnitStats() const
     return stats;
 }
 
-void Tile::SetOwnership(const std::shared_ptr<Player>& player)
+void Tile::SetOwnership(Player* player)
 {
     m_OwnedBy = player;
+    s_OwnershipVersion++;
+    s_StateVersion++;
 }
 
-void Tile::ChangeOwnership(const std::shared_ptr<Player>& player)
+void Tile::ChangeOwnership(Player* player)
 {
     if(m_OwnedBy != nullptr)
-        m_OwnedBy->RemoveOwnedTile(shared_from_this());
+        m_OwnedBy->RemoveOwnedTile(this);
 
-    player->AddOwnedTile(shared_from_this());
+    player->AddOwnedTile(this);
 }
 
-void Tile::MoveToTile(const std::shared_ptr<Tile>& destTile)
+void Tile::MoveToTile(Tile* destTile)
 {
+    // Battles remove unit groups on both tiles even when ownership stays the same
+    s_StateVersion++;
+    InvalidateRenderCache();
+    destTile->InvalidateRenderCache();
+
     if(destTile->m_OwnedBy == m_OwnedBy)
     {
         TransferUnitGroupsToTile(destTile);
         return;
     }
 
-    if (destTile->GetPotion()->IsApplied() && destTile->GetPotion()->GetType() == PotionType::IMMUNITY)
+    if (destTile->GetPotion().IsApplied() && destTile->GetPotion().GetType() == PotionType::IMMUNITY)
     {
         Notification::Create("Cannot attack because the tile has immunity potion applied", NotificationLevel::INFO);
         return;
     }
 
-    if(Battle::CalculateBattleOutcome(shared_from_this(), destTile) == BattleOutcome::ATTACKER_WON)
+    if(Battle::CalculateBattleOutcome(this, destTile) == BattleOutcome::ATTACKER_WON)
     {
-        destTile->GetUnitGroups().clear();
-        auto defender = destTile->GetOwnedBy();
+        destTile->DestroyUnitGroups([](UnitGroup*) { return true; });
+        Player* defender = destTile->GetOwnedBy();
         destTile->ChangeOwnership(this->m_OwnedBy);
         TransferUnitGroupsToTile(destTile);
 
-        GameLayer::Get().GetPlayerManager()->UpdatePlayerStatus(defender);
+        GameLayer::Get().GetPlayerManager()->UpdatePlayerStatus(defender ? defender->shared_from_this() : nullptr);
     }
 }
 
-void Tile::TransferUnitGroupsToTile(const std::shared_ptr<Tile>& destTile)
+void Tile::TransferUnitGroupsToTile(Tile* destTile)
 {
-    if (destTile.get() == this) return;
+    if (destTile == this) return;
 
     for (auto unit : m_UnitGroups)
     {
@@ -901,37 +942,30 @@ void Tile::EraseSelectedUnitGroups()
     m_UnitGroups.erase(std::remove_if(m_UnitGroups.begin(), m_UnitGroups.end(), [](UnitGroup* unit) {
         return unit->IsSelected();
     }), m_UnitGroups.end());
+
+    s_StateVersion++;
+    InvalidateRenderCache();
 }
 
 bool Tile::HandleUnitGroupMouseClick(const glm::vec2& relMousePos)
 {
-    auto unitData = GetUnitGroupDrawData();
-    float initialX = unitData.Position.x;
+    const auto& cache = UpdateRenderCache();
 
     for (int i = 0; i < m_UnitGroups.size(); i++)
     {
         if (Util::IsPointInRectangle(
-            unitData.Position,
-            unitData.Size,
-             relMousePos))
+            cache.UnitGroupSlots[i],
+            cache.UnitGroupData.Size,
+            relMousePos))
         {
             if (!m_UnitGroups[i]->UnitWasMovedInIteration(GameLayer::Get().GetIteration()))
             {
                 m_UnitGroups[i]->ToggleSelected();
+                InvalidateRenderCache();
             }
 
             return true;
         }
-
-        if ((i + 1) % s_UnitGroupsPerRow == 0)
-        {
-            unitData.Position.x = initialX;
-            unitData.Position.y -= (unitData.OffsetSize.y + unitData.Size.y);
-        }
-        else
-        {
-            unitData.Position.x += unitData.Size.x + unitData.OffsetSize.x;
-        }
     }
 
     return false;
@@ -939,14 +973,14 @@ bool Tile::HandleUnitGroupMouseClick(const glm::vec2& relMousePos)
 
 bool Tile::HandleBuildingUpgradeIconMouseClick(const glm::vec2& relMousePos)
 {
-    auto buildingData = GetBuildingDrawData();
-    float initialX = buildingData.Position.x;
+    const auto& cache = UpdateRenderCache();
+    const auto& buildingData = cache.BuildingData;
     static glm::vec2 upgradeIconSize = buildingData.Size * 0.3f;
 
     for (int i = 0; i < m_Buildings.size(); i++)
     {
         if (Util::IsPointInRectangle(
-            buildingData.Position + buildingData.Size / 2.0f - upgradeIconSize / 2.0f,
+            cache.BuildingSlots[i] + buildingData.Size / 2.0f - upgradeIconSize / 2.0f,
             upgradeIconSize,
             relMousePos))
         {
@@ -954,19 +988,10 @@ bool Tile::HandleBuildingUpgradeIconMouseClick(const glm::vec2& relMousePos)
             if (GameLayer::Get().GetPlayerManager()->GetCurrentPlayer()->SubtractResources(upgradeCost))
             {
                 m_Buildings[i]->Upgrade();
+                InvalidateRenderCache();
                 return true;
             }
         }
-
-        if ((i + 1) % s_BuildingsPerRow == 0)
-        {
-            buildingData.Position.x = initialX;
-            buildingData.Position.y -= (buildingData.OffsetSize.y + buildingData.Size.y);
-        }
-        else
-        {
-            buildingData.Position.x += buildingData.Size.x + buildingData.OffsetSize.x;
-        }
     }
 
     return false;
@@ -974,7 +999,7 @@ bool Tile::HandleBuildingUpgradeIconMouseClick(const glm::vec2& relMousePos)
 
 bool Tile::IsMouseClickedInsideUnitGroupsBox(const glm::vec2& relMousePos)
 {
-    auto unitData = GetUnitGroupDrawData();
+    const auto& unitData = UpdateRenderCache().UnitGroupData;
     return Util::IsPointInRectangle(unitData.BackgroundPosition, unitData.BackgroundSize, relMousePos);
 }
 
@@ -982,40 +1007,16 @@ void Tile::DeselectAllUnitGroups()
 {
     for (auto unit : m_UnitGroups)
         unit->SetSelected(false);
+
+    InvalidateRenderCache();
 }
 
 bool Tile::InRange(const glm::vec2& cursorPos)
 {
-    static float w = TILE_WIDTH;
-    static float h = TILE_HEIGHT;
-
-    std::vector<glm::vec2> vertices = {
-        {m_Position.x - w/2, m_Position.y},
-        {m_Position.x - w/4, m_Position.y + h/2},
-        {m_Position.x + w/4, m_Position.y + h/2},
-        {m_Position.x + w/2, m_Position.y},
-        {m_Position.x + w/4, m_Position.y - h/2},
-        {m_Position.x - w/4, m_Position.y - h/2}
-    };
-
-    std::vector<glm::vec3> equations;
-    for (int i = 0; i < 6; i++)
-    {
-        glm::vec2 v1 = vertices[i];
-        glm::vec2 v2 = vertices[(i + 1) % 6];
-        float A = v1.y - v2.y;
-        float B = v2.x - v1.x;
-        float C = v1.x * v2.y - v2.x * v1.y;
-        equations.push_back({A, B, C});
-    }
-
-    for (auto eq : equations)
-    {
-        if (eq.x * cursorPos.x + eq.y * cursorPos.y + eq.z > 0)
-            return false;
-    }
-
-    return true;
+    // Hexagon is symmetric along both axes, so the position is tested against its top right quarter:
+    // below the top edge and left of the edge running from the right corner to the top one
+    glm::vec2 offset = glm::abs(cursorPos - m_Position);
+    return offset.y <= TILE_HEIGHT / 2.0f && offset.x + offset.y * (TILE_WIDTH / 2.0f) / TILE_HEIGHT <= TILE_WIDTH / 2.0f;
 }
 
 bool Tile::HasSelectedUnitGroups()
@@ -1050,6 +1051,20 @@ bool Tile::IsAdjacent(const glm::ivec2& tile1, const glm::ivec2& tile2)
     return false;
 }
 
+TileDetail Tile::CalculateDetail(const std::shared_ptr<OrthographicCamera>& camera)
+{
+    float tileHeightPx = camera->ConvertRelativeSizeToPixel({ TILE_WIDTH, TILE_HEIGHT }).y;
+
+    if (tileHeightPx >= TILE_DETAIL_TEXT_MIN_HEIGHT_PX)
+        return TileDetail::FULL;
+    if (tileHeightPx >= TILE_DETAIL_ICONS_MIN_HEIGHT_PX)
+        return TileDetail::ICONS;
+    if (tileHeightPx >= TILE_DETAIL_GLYPH_MIN_HEIGHT_PX)
+        return TileDetail::AGGREGATED;
+
+    return TileDetail::COLOR;
+}
+
 glm::vec2 Tile::CalculateTilePosition(int x, int y)
 {
     float w = TILE_WIDTH;
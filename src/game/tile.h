@@ -3,10 +3,12 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include <functional>
 
 #include <glm/glm.hpp>
 
 #include "core/camera.h"
+#include "graphics/shader.h"
 #include "game/unit.h"
 #include "game/building.h"
 #include "game/potion.h"
@@ -15,7 +17,15 @@
 #define TILE_HEIGHT (glm::sqrt(3))
 #define TILE_OFFSET  0.1f
 
+// on-screen tile height in pixels below which tile contents are drawn with less detail
+#define TILE_DETAIL_TEXT_MIN_HEIGHT_PX  150.0f
+#define TILE_DETAIL_ICONS_MIN_HEIGHT_PX 75.0f
+#define TILE_DETAIL_GLYPH_MIN_HEIGHT_PX 30.0f
+// army strength at which the aggregated army glyph reaches its full size
+#define TILE_DETAIL_GLYPH_MAX_STRENGTH  250.0f
+
 class Player;
+class HexagonInstances;
 
 struct DrawData
 {
@@ -26,6 +36,23 @@ struct DrawData
     glm::vec2 BackgroundSize;
 };
 
+// Layout, summed stats and labels of the unit groups and buildings of a tile,
+// rebuilt only after the tile contents change instead of on every frame
+struct TileRenderCache
+{
+    DrawData UnitGroupData;
+    DrawData BuildingData;
+    std::vector<glm::vec2> UnitGroupSlots;
+    std::vector<glm::vec2> BuildingSlots;
+    UnitStats TotalStats;
+    UnitStats SelectedStats;
+    std::vector<std::string> StatLabels;
+    std::vector<std::string> BuildingLabels;
+    unsigned int LayoutVersion = 0;
+    bool LabelsForOwner = false;
+    bool Dirty = true;
+};
+
 enum class TileEnvironment
 {
     NONE,
@@ -36,23 +63,39 @@ enum class TileEnvironment
     HIGHLIGHT
 };
 
-class Tile : public std::enable_shared_from_this<Tile>
+enum class TileDetail
+{
+    FULL       = 0, // unit and building icons with stats and labels
+    ICONS      = 1, // icons without any text
+    AGGREGATED = 2, // single glyph sized by the strength of the army
+    COLOR      = 3  // only terrain and ownership colors
+};
+
+// Tiles are stored by value in GameMap and never move after the map is created,
+// so other objects refer to them through plain pointers
+class Tile
 {
 public:
     Tile(TileEnvironment environment, const glm::ivec2& coords);
+    Tile(Tile&& other) = default;
+    Tile(const Tile&) = delete;
+    Tile& operator=(const Tile&) = delete;
     ~Tile();
 
-    void MoveToTile(const std::shared_ptr<Tile>& destTile);
+    void MoveToTile(Tile* destTile);
     void CreateUnitGroup(UnitGroupType type);
-    void CreateUnitGroup(UnitGroup unitGroup);
+    void CreateUnitGroup(const UnitGroup& unitGroup);
+    // Unit groups matching the condition are removed from the tile and returned to UnitGroupPool
+    void DestroyUnitGroups(const std::function<bool(UnitGroup*)>& condition);
     bool CanRecruitUnitGroup(UnitGroupType type);
     bool HasSpaceForUnitGroups(int num);
     bool HasSpaceForBuildings(int num);
     void CreateBuilding(BuildingType type);
-    void CreateBuilding(Building building);
+    void CreateBuilding(const Building& building);
     void DeselectAllUnitGroups();
-    void Draw();
-    void DrawEnvironment(const std::shared_ptr<OrthographicCamera>& camera);
+    void Draw(TileDetail detail = TileDetail::FULL, bool drawDecoration = true);
+    void DrawEnvironment(bool drawTerrain = true, bool drawDecoration = true, bool drawWater = true);
+    void SubmitTerrain(const std::shared_ptr<HexagonInstances>& instances) const;
     bool HasSelectedUnitGroups();
     bool InRange(const glm::vec2& cursorPos);
     bool HandleUnitGroupMouseClick(const glm::vec2& relMousePos);
@@ -63,26 +106,27 @@ public:
     void CheckBuildingHover(const glm::vec2& relMousePos);
     void SelectAllUnitGroups();
     void TickPotion();
-    std::shared_ptr<Potion> GetPotion() { return m_Potion; }
+    inline Potion& GetPotion() { return m_Potion; }
     inline const TileEnvironment GetEnvironment() const { return m_Environment; }
     inline const void SetEnvironment(TileEnvironment environment) { m_Environment = environment; }
-    inline const std::shared_ptr<Player>& GetOwnedBy() const { return m_OwnedBy; }
+    inline Player* GetOwnedBy() const { return m_OwnedBy; }
     std::vector<UnitGroup*>& GetUnitGroups() { return m_UnitGroups; }
     std::vector<Building*>& GetBuildings() { return m_Buildings; }
-    inline const bool IsOwned() const { return m_OwnedBy.get() != nullptr; }
+    inline const bool IsOwned() const { return m_OwnedBy != nullptr; }
     inline const glm::vec2& GetPosition() const { return m_Position; }
     inline const glm::ivec2& GetCoords() const { return m_Coords; }
     const Resources GetResources() const;
     int GetNumSelectedUnitGroups();
     UnitStats GetTotalUnitStats() const;
 
-    void SetOwnership(const std::shared_ptr<Player>& player);
-    void ChangeOwnership(const std::shared_ptr<Player>& player);
+    void SetOwnership(Player* player);
+    void ChangeOwnership(Player* player);
     void AddRandomUnits();
 
 public:
     static bool IsAdjacent(const glm::ivec2& tile1, const glm::ivec2& tile2);
     static glm::vec2 CalculateTilePosition(int x, int y);
+    static TileDetail CalculateDetail(const std::shared_ptr<OrthographicCamera>& camera);
     static std::string GetEnvironmentName(TileEnvironment environment);
 
 public:
@@ -100,29 +144,43 @@ public:
     static const char* s_StatTextures[];
     static const std::vector<glm::ivec2> s_AdjacentTileOffsets;
 
+    // incremented on every ownership change, lets views redraw what they cache only when it changed
+    static unsigned int s_OwnershipVersion;
+    // incremented whenever ownership, unit groups or potions of any tile change, see TileEffects
+    static unsigned int s_StateVersion;
+    // incremented when the layout settings above change, makes every tile recalculate its cached slot positions
+    static unsigned int s_LayoutVersion;
+
 private:
     void InitStaticRuntimeData();
     void DrawUnitGroupStats(DrawData& unitData, UnitGroup* unitGroup);
-    void DrawCountedStats(DrawData& unitData, int totalStats[], int selectedStats[]);
-    void DrawUnitGroups();
-    void DrawBuildings();
-    void DrawPotionEffect();
+    void DrawCountedStats();
+    void DrawUnitGroups(bool drawText);
+    void DrawArmyStrength();
+    void DrawBuildings(bool drawText);
+    void DrawPotionLabel();
     void DrawEarnedResourcesInfoOverlay();
     void EraseSelectedUnitGroups();
-    void TransferUnitGroupsToTile(const std::shared_ptr<Tile>& destTile);
-    DrawData GetUnitGroupDrawData();
-    DrawData GetBuildingDrawData();
+    void TransferUnitGroupsToTile(Tile* destTile);
+    ShaderParams GetEffectShaderParams(const glm::vec4& color = glm::vec4(1.0f)) const;
+    DrawData CalculateUnitGroupDrawData() const;
+    DrawData CalculateBuildingDrawData() const;
+    void InvalidateRenderCache() { if (m_RenderCache) m_RenderCache->Dirty = true; }
+    const TileRenderCache& UpdateRenderCache();
+
+    static std::vector<glm::vec2> CalculateSlots(const DrawData& data, int count, int perRow);
 
 private:
     static std::shared_ptr<Texture2D> s_UpgradeIconTexture;
 
 private:
     TileEnvironment m_Environment;
-    Resources m_Resources;
     glm::ivec2 m_Coords;
     glm::vec2 m_Position;
-    std::shared_ptr<Player> m_OwnedBy;
+    Player* m_OwnedBy;
+    Resources m_Resources;
     std::vector<UnitGroup*> m_UnitGroups;
     std::vector<Building*> m_Buildings;
-    std::shared_ptr<Potion> m_Potion;
+    Potion m_Potion;
+    std::unique_ptr<TileRenderCache> m_RenderCache;
 };
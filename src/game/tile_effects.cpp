@@ -0,0 +1,113 @@
+#include "tile_effects.h"
+
+#include "core/resource_manager.h"
+#include "graphics/renderer.h"
+#include "game/tile.h"
+
+TileEffects::TileEffects()
+    : m_WrittenStateVersion(0), m_WrittenIteration(-1)
+{
+    m_GlowInstances = std::make_shared<HexagonInstances>();
+    m_PotionInstances = std::make_shared<HexagonInstances>();
+    m_GlowShader = ResourceManager::GetShader("hue");
+    m_PotionShader = ResourceManager::GetShader("potion");
+}
+
+void TileEffects::Update(const std::shared_ptr<GameMap>& gameMap, const std::shared_ptr<Player>& currentPlayer, int iteration)
+{
+    if (m_GameMap != gameMap)
+    {
+        Rebuild(gameMap);
+        WriteTileState(currentPlayer, iteration);
+        return;
+    }
+
+    // Unmoved units are only flagged for the current player and depend on the iteration they moved in
+    if (m_WrittenStateVersion != Tile::s_StateVersion || m_WrittenPlayer != currentPlayer || m_WrittenIteration != iteration)
+        WriteTileState(currentPlayer, iteration);
+}
+
+void TileEffects::DrawOwnershipGlow()
+{
+    Renderer2D::DrawHexagonInstances(m_GlowInstances, m_GlowShader, m_TileStateTexture);
+}
+
+void TileEffects::DrawPotionEffects()
+{
+    Renderer2D::DrawHexagonInstances(m_PotionInstances, m_PotionShader, m_TileStateTexture);
+}
+
+void TileEffects::Rebuild(const std::shared_ptr<GameMap>& gameMap)
+{
+    m_GameMap = gameMap;
+
+    // Instance color is not drawn by the effect shaders, it carries the tile coordinates to look the state up with
+    m_GlowInstances->Clear();
+    m_PotionInstances->Clear();
+    for (const auto& tile : gameMap->GetTiles())
+    {
+        if (!tile.AssetsCanExist())
+            continue;
+
+        glm::vec4 tileCoords = { (float)tile.GetCoords().x, (float)tile.GetCoords().y, 0.0f, 0.0f };
+        m_GlowInstances->Add(tile.GetPosition(), glm::vec2(2.0f), tileCoords);
+        m_PotionInstances->Add(tile.GetPosition(), glm::vec2(1.0f), tileCoords);
+    }
+
+    m_TileState.assign(gameMap->GetTileCountX() * gameMap->GetTileCountY() * 4, 0);
+
+    TextureData textureData;
+    textureData.Size = { gameMap->GetTileCountX(), gameMap->GetTileCountY() };
+    textureData.Data = m_TileState.data();
+    textureData.NrChannels = 4;
+    textureData.WrapHorizontal = TextureWrap::CLAMP_TO_EDGE;
+    textureData.WrapVertical = TextureWrap::CLAMP_TO_EDGE;
+    textureData.MinFilter = TextureFilter::NEAREST;
+    textureData.MagFilter = TextureFilter::NEAREST;
+    m_TileStateTexture = std::make_shared<Texture2D>(textureData);
+}
+
+void TileEffects::WriteTileState(const std::shared_ptr<Player>& currentPlayer, int iteration)
+{
+    // Texels are laid out row by row like the tiles, so both are walked together
+    unsigned char* texel = m_TileState.data();
+    for (auto& tile : m_GameMap->GetTiles())
+    {
+        glm::vec3 color(0.0f);
+        unsigned char flags = 0;
+
+        Player* ownedBy = tile.GetOwnedBy();
+        if (ownedBy)
+        {
+            color = ownedBy->GetColor();
+            flags |= TILE_STATE_OWNED_BIT;
+
+            if (ownedBy == currentPlayer.get())
+            {
+                for (auto unitGroup : tile.GetUnitGroups())
+                {
+                    if (unitGroup->GetMovedOnIteration() != iteration)
+                    {
+                        flags |= TILE_STATE_UNMOVED_BIT;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (tile.GetPotion().IsApplied())
+            flags |= ((int)tile.GetPotion().GetType() + 1) << TILE_STATE_POTION_SHIFT;
+
+        texel[0] = (unsigned char)(color.r * 255.0f);
+        texel[1] = (unsigned char)(color.g * 255.0f);
+        texel[2] = (unsigned char)(color.b * 255.0f);
+        texel[3] = flags;
+        texel += 4;
+    }
+
+    m_TileStateTexture->SetData(m_TileState.data());
+
+    m_WrittenStateVersion = Tile::s_StateVersion;
+    m_WrittenPlayer = currentPlayer;
+    m_WrittenIteration = iteration;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "graphics/shader.h"
+#include "graphics/texture.h"
+#include "graphics/hexagon_instances.h"
+#include "game/map.h"
+#include "game/player.h"
+
+// bits of the alpha channel of the tile state texture (must match hue.glsl and potion.glsl)
+#define TILE_STATE_OWNED_BIT      0x1
+#define TILE_STATE_UNMOVED_BIT    0x2
+// potion type is stored one based above the flag bits, 0 when no potion is applied
+#define TILE_STATE_POTION_SHIFT   2
+
+// Ownership glow and potion effects of every tile, each drawn in a single instanced pass.
+// Owner color, the unmoved units flag and the potion type of all tiles live in a small RGBA texture
+// with one texel per tile, which the effect shaders sample. The texture is only written again after
+// tile state, the current player or the iteration changed.
+class TileEffects
+{
+public:
+    TileEffects();
+    ~TileEffects() = default;
+
+    void Update(const std::shared_ptr<GameMap>& gameMap, const std::shared_ptr<Player>& currentPlayer, int iteration);
+
+    void DrawOwnershipGlow();
+    void DrawPotionEffects();
+
+private:
+    void Rebuild(const std::shared_ptr<GameMap>& gameMap);
+    void WriteTileState(const std::shared_ptr<Player>& currentPlayer, int iteration);
+
+private:
+    std::shared_ptr<GameMap> m_GameMap;
+    std::vector<unsigned char> m_TileState;
+    std::shared_ptr<Texture2D> m_TileStateTexture;
+
+    std::shared_ptr<HexagonInstances> m_GlowInstances;
+    std::shared_ptr<HexagonInstances> m_PotionInstances;
+    std::shared_ptr<Shader> m_GlowShader;
+    std::shared_ptr<Shader> m_PotionShader;
+
+    unsigned int m_WrittenStateVersion;
+    std::shared_ptr<Player> m_WrittenPlayer;
+    int m_WrittenIteration;
+};
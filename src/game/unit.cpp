@@ -2,6 +2,9 @@
 
 #include "core/logger.h"
 
+ObjectPool<UnitStats> UnitStatsPool("unit stats");
+ObjectPool<UnitGroup> UnitGroupPool("unit group");
+
 std::unordered_map<UnitGroupType, UnitGroupData> UnitGroupDataMap = {
     { UnitGroupType::SWORDSMAN, { { 2, 2, 2, 3 }, { 3,  4,  6 }, "swordsman", BuildingType::NONE         } },
     { UnitGroupType::ARCHER,    { { 4, 3, 2, 4 }, { 5,  2,  4 },    "archer", BuildingType::TARGET       } },
@@ -33,17 +36,51 @@ bool UnitStats::operator>(UnitStats stats)
     return this->Attack + this->Defense + this->Health > stats.Attack + stats.Defense + stats.Health;
 }
 
-UnitGroup::UnitGroup(UnitGroupType type, std::optional<UnitStats*> stats, int movedOnIteration)
+UnitGroup::UnitGroup(UnitGroupType type, std::optional<UnitStats> stats, int movedOnIteration)
     : m_Type(type), m_IsSelected(false), m_MovedOnIteration(movedOnIteration)
 {
-    auto unitStats = stats.has_value() ? stats.value() : new UnitStats(UnitGroupDataMap[type].Stats);
-    m_Stats.push_back(unitStats);
+    m_Stats.push_back(UnitStatsPool.Create(stats.has_value() ? stats.value() : UnitGroupDataMap[type].Stats));
+}
+
+UnitGroup::UnitGroup(const UnitGroup& other)
+    : m_Type(other.m_Type), m_MovedOnIteration(other.m_MovedOnIteration), m_IsSelected(other.m_IsSelected)
+{
+    m_Stats.reserve(other.m_Stats.size());
+    for (auto stats : other.m_Stats)
+        m_Stats.push_back(UnitStatsPool.Create(*stats));
+}
+
+UnitGroup::~UnitGroup()
+{
+    for (auto stats : m_Stats)
+        UnitStatsPool.Destroy(stats);
 }
 
 void UnitGroup::IncrementQuantity(int quantity)
 {
     if (quantity > 0)
-        m_Stats.insert(m_Stats.end(), quantity, new UnitStats(UnitGroupDataMap[m_Type].Stats));
+    {
+        m_Stats.reserve(m_Stats.size() + quantity);
+        for (int i = 0; i < quantity; i++)
+            m_Stats.push_back(UnitStatsPool.Create(UnitGroupDataMap[m_Type].Stats));
+    }
     else
         LOG_WARN("Trying to increment unit quantity with incorrect value: {0}", quantity);
 }
+
+int UnitGroup::RemoveDeadUnits()
+{
+    // Order of the remaining units is kept, battles pair units by their position
+    size_t alive = 0;
+    for (size_t i = 0; i < m_Stats.size(); i++)
+    {
+        if (m_Stats[i]->Health > 0)
+            m_Stats[alive++] = m_Stats[i];
+        else
+            UnitStatsPool.Destroy(m_Stats[i]);
+    }
+
+    int removed = m_Stats.size() - alive;
+    m_Stats.resize(alive);
+    return removed;
+}
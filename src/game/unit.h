@@ -5,6 +5,7 @@
 #include <optional>
 #include <unordered_map>
 
+#include "core/object_pool.h"
 #include "game/building.h"
 #include "game/resource.h"
 
@@ -40,11 +41,15 @@ struct UnitGroupData
 
 extern std::unordered_map<UnitGroupType, UnitGroupData> UnitGroupDataMap;
 
+// Stats of every unit come from UnitStatsPool and are returned to it by the group
 class UnitGroup
 {
 public:
-    UnitGroup(UnitGroupType type, std::optional<UnitStats*> stats = std::nullopt, int movedOnIteration = 0);
-    ~UnitGroup() = default;
+    UnitGroup(UnitGroupType type, std::optional<UnitStats> stats = std::nullopt, int movedOnIteration = 0);
+    // Copies get their own unit stats
+    UnitGroup(const UnitGroup& other);
+    UnitGroup& operator=(const UnitGroup&) = delete;
+    ~UnitGroup();
 
     void ToggleSelected() { m_IsSelected = !m_IsSelected; }
     void SetSelected(bool isSelected) { m_IsSelected = isSelected; }
@@ -52,8 +57,9 @@ public:
 
     int GetMovedOnIteration() { return m_MovedOnIteration; }
 
-    // TODO: Rethink
     void IncrementQuantity(int quantity = 1);
+    // Releases units without health left, returns how many were removed
+    int RemoveDeadUnits();
 
     std::vector<UnitStats*>& GetUnitStats() { return m_Stats; }
     const UnitGroupType GetType() const { return m_Type; }
@@ -66,3 +72,7 @@ private:
     std::vector<UnitStats*> m_Stats;
     bool m_IsSelected;
 };
+
+// Defined in this order so unit groups left at exit can still return their stats
+extern ObjectPool<UnitStats> UnitStatsPool;
+extern ObjectPool<UnitGroup> UnitGroupPool;
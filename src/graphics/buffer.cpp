@@ -3,41 +3,53 @@
 #include <numeric>
 
 #include "core/logger.h"
-#include "core/application.h"
+#include "graphics/render_state.h"
+#include "graphics/graphics_context.h"
 
 VertexBuffer::VertexBuffer(float* vertices, unsigned int size, unsigned int usage)
+    : m_BufferID(0)
 {
+    if (!GraphicsContext::IsAvailable())
+        return;
+
     glGenBuffers(1, &m_BufferID);
-    glBindBuffer(GL_ARRAY_BUFFER, m_BufferID);
+    RenderState::BindBuffer(GL_ARRAY_BUFFER, m_BufferID);
     glBufferData(GL_ARRAY_BUFFER, size, vertices, usage);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    RenderState::BindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
 VertexBuffer::~VertexBuffer()
 {
+    if (!GraphicsContext::IsAvailable())
+        return;
+
     glDeleteBuffers(1, &m_BufferID);
+    RenderState::OnBufferDeleted(m_BufferID);
 }
 
 void VertexBuffer::Bind() const
 {
-    glBindBuffer(GL_ARRAY_BUFFER, m_BufferID);
+    RenderState::BindBuffer(GL_ARRAY_BUFFER, m_BufferID);
 }
 
 void VertexBuffer::Unbind() const
 {
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    RenderState::BindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
-void VertexBuffer::SetLayout(const std::vector<int>& layout)
+void VertexBuffer::SetLayout(const std::vector<int>& layout, unsigned int firstAttribute, unsigned int divisor)
 {
+    if (!GraphicsContext::IsAvailable())
+        return;
+
     int stride = std::accumulate(layout.begin(), layout.end(), 0);
 
     int offset = 0;
     for (int i = 0; i < layout.size(); i++)
     {
-        glEnableVertexAttribArray(i);
+        glEnableVertexAttribArray(firstAttribute + i);
         glVertexAttribPointer(
-            i,
+            firstAttribute + i,
             layout[i],
             GL_FLOAT,
             GL_FALSE,
@@ -45,66 +57,132 @@ void VertexBuffer::SetLayout(const std::vector<int>& layout)
             (const void*)(offset * sizeof(float))
         );
 
+        // Non-zero divisor advances the attribute per instance instead of per vertex
+        if (divisor > 0)
+            glVertexAttribDivisor(firstAttribute + i, divisor);
+
         offset += layout[i];
     }
 }
 
+void VertexBuffer::SetData(float* data, unsigned int size, unsigned int usage)
+{
+    if (!GraphicsContext::IsAvailable())
+        return;
+
+    glBufferData(GL_ARRAY_BUFFER, size, data, usage);
+}
+
 void VertexBuffer::UpdateData(float* data, unsigned int offset, unsigned int size)
 {
+    if (!GraphicsContext::IsAvailable())
+        return;
+
     glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
 }
 
 IndexBuffer::IndexBuffer(unsigned int* indices, unsigned int count)
+    : m_BufferID(0), m_IndexCount(count)
 {
+    if (!GraphicsContext::IsAvailable())
+        return;
+
+    // The element buffer binding is stored in the bound vertex array, which must not pick up this buffer
+    RenderState::BindVertexArray(0);
+
     glGenBuffers(1, &m_BufferID);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_BufferID);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(unsigned int), indices, GL_STATIC_DRAW);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
-    m_IndexCount = count;
 }
 
 IndexBuffer::~IndexBuffer()
 {
+    if (!GraphicsContext::IsAvailable())
+        return;
+
     glDeleteBuffers(1, &m_BufferID);
 }
 
 void IndexBuffer::Bind() const
 {
+    if (!GraphicsContext::IsAvailable())
+        return;
+
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_BufferID);
 }
 
 void IndexBuffer::Unbind() const
 {
+    if (!GraphicsContext::IsAvailable())
+        return;
+
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
 
-FrameBuffer::FrameBuffer(unsigned int width, unsigned int height)
-    : m_Width(width), m_Height(height)
+// Re-specifies the whole index storage. Binds the buffer to GL_ELEMENT_ARRAY_BUFFER,
+// so the vertex array owning this buffer has to be bound beforehand.
+void IndexBuffer::SetData(unsigned int* indices, unsigned int count)
+{
+    m_IndexCount = count;
+
+    if (!GraphicsContext::IsAvailable())
+        return;
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_BufferID);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(unsigned int), indices, GL_STATIC_DRAW);
+}
+
+UniformBuffer::UniformBuffer(unsigned int size, unsigned int binding)
+{
+    glGenBuffers(1, &m_BufferID);
+    RenderState::BindBuffer(GL_UNIFORM_BUFFER, m_BufferID);
+    glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+    glBindBufferBase(GL_UNIFORM_BUFFER, binding, m_BufferID);
+}
+
+UniformBuffer::~UniformBuffer()
+{
+    glDeleteBuffers(1, &m_BufferID);
+    RenderState::OnBufferDeleted(m_BufferID);
+}
+
+void UniformBuffer::SetData(const void* data, unsigned int size, unsigned int offset)
+{
+    RenderState::BindBuffer(GL_UNIFORM_BUFFER, m_BufferID);
+    glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+}
+
+FrameBuffer::FrameBuffer(unsigned int width, unsigned int height, unsigned int nrChannels)
+    : m_Width(width), m_Height(height), m_IntermediateBufferID(0), m_MultiSampledBufferID(0), m_MultiSampledRenderBufferID(0)
 {
     TextureData textureData;
     textureData.Size = { m_Width, m_Height };
-    textureData.NrChannels = 3;
+    textureData.NrChannels = nrChannels;
     textureData.IsMultisample = true;
 
     m_MultiSampledColorTexture = std::make_shared<Texture2D>(textureData);
+
+    textureData.IsMultisample = false;
+    m_DisplayedColorTexture = std::make_shared<Texture2D>(textureData);
+
+    // Without a context the textures are still there, so recorded frames can draw them
+    if (!GraphicsContext::IsAvailable())
+        return;
+
     glGenFramebuffers(1, &m_MultiSampledBufferID);
     glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_MultiSampledBufferID);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D_MULTISAMPLE, m_MultiSampledColorTexture->GetID(), 0);
 
-    unsigned int multiSampledRenderBuffer;
-    glGenRenderbuffers(1, &multiSampledRenderBuffer);
-    glBindRenderbuffer(GL_RENDERBUFFER, multiSampledRenderBuffer);
+    glGenRenderbuffers(1, &m_MultiSampledRenderBufferID);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_MultiSampledRenderBufferID);
     glRenderbufferStorageMultisample(GL_RENDERBUFFER, 4, GL_DEPTH24_STENCIL8, m_Width, m_Height);
     glBindRenderbuffer(GL_RENDERBUFFER, 0);
 
-    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, multiSampledRenderBuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_MultiSampledRenderBufferID);
 
     if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
         LOG_ERROR("Framebuffer: Incomplete multisampled framebuffer");
 
-    textureData.IsMultisample = false;
-    m_DisplayedColorTexture = std::make_shared<Texture2D>(textureData);
     glGenFramebuffers(1, &m_IntermediateBufferID);
     glBindFramebuffer(GL_FRAMEBUFFER, m_IntermediateBufferID);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_DisplayedColorTexture->GetID(), 0);
@@ -117,8 +195,12 @@ FrameBuffer::FrameBuffer(unsigned int width, unsigned int height)
 
 FrameBuffer::~FrameBuffer()
 {
+    if (!GraphicsContext::IsAvailable())
+        return;
+
     glDeleteFramebuffers(1, &m_IntermediateBufferID);
     glDeleteFramebuffers(1, &m_MultiSampledBufferID);
+    glDeleteRenderbuffers(1, &m_MultiSampledRenderBufferID);
 }
 
 void FrameBuffer::Bind() const
@@ -127,11 +209,16 @@ void FrameBuffer::Bind() const
     glViewport(0, 0, m_Width, m_Height);
 }
 
+void FrameBuffer::Bind(unsigned int viewportWidth, unsigned int viewportHeight) const
+{
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_MultiSampledBufferID);
+    glViewport(0, 0, glm::min(viewportWidth, m_Width), glm::min(viewportHeight, m_Height));
+}
+
+// The viewport is left to the caller, GLRenderBackend restores the one the framebuffer was bound over
 void FrameBuffer::Unbind() const
 {
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    auto window = Application::Get().GetWindow();
-    glViewport(0, 0, window->GetWidth(), window->GetHeight());
 }
 
 void FrameBuffer::PostProcess() const
@@ -140,3 +227,20 @@ void FrameBuffer::PostProcess() const
     glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_IntermediateBufferID);
     glBlitFramebuffer(0, 0, m_Width, m_Height, 0, 0, m_Width, m_Height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
 }
+
+void FrameBuffer::ResolveInto(const Texture2D& texture) const
+{
+    unsigned int width = glm::min(texture.GetWidth(), m_Width);
+    unsigned int height = glm::min(texture.GetHeight(), m_Height);
+
+    unsigned int resolveBufferID;
+    glGenFramebuffers(1, &resolveBufferID);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, resolveBufferID);
+    glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture.GetID(), 0);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_MultiSampledBufferID);
+    glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &resolveBufferID);
+}
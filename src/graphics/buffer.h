@@ -16,7 +16,8 @@ public:
     void Bind() const;
     void Unbind() const;
 
-    void SetLayout(const std::vector<int>& layout);
+    void SetLayout(const std::vector<int>& layout, unsigned int firstAttribute = 0, unsigned int divisor = 0);
+    void SetData(float* data, unsigned int size, unsigned int usage = GL_DYNAMIC_DRAW);
     void UpdateData(float* data, unsigned int offset, unsigned int size);
 
 private:
@@ -32,6 +33,8 @@ public:
     void Bind() const;
     void Unbind() const;
 
+    void SetData(unsigned int* indices, unsigned int count);
+
     inline unsigned int GetIndexCount() const { return m_IndexCount; }
 
 private:
@@ -39,16 +42,35 @@ private:
     unsigned int m_IndexCount;
 };
 
+class UniformBuffer
+{
+public:
+    UniformBuffer(unsigned int size, unsigned int binding);
+    ~UniformBuffer();
+
+    void SetData(const void* data, unsigned int size, unsigned int offset = 0);
+
+private:
+    unsigned int m_BufferID;
+};
+
 class FrameBuffer
 {
 public:
-    FrameBuffer(unsigned int width, unsigned int height);
+    FrameBuffer(unsigned int width, unsigned int height, unsigned int nrChannels = 3);
     ~FrameBuffer();
 
     void Bind() const;
+    // Renders only into the bottom left corner of the given size
+    void Bind(unsigned int viewportWidth, unsigned int viewportHeight) const;
     void Unbind() const;
 
     void PostProcess() const;
+    // Resolves the bottom left corner of the size of the texture into it instead of the displayed texture
+    void ResolveInto(const Texture2D& texture) const;
+
+    inline unsigned int GetWidth() const { return m_Width; }
+    inline unsigned int GetHeight() const { return m_Height; }
 
     inline const std::shared_ptr<Texture2D>& GetTexture() const { return m_DisplayedColorTexture; }
 
@@ -56,6 +78,7 @@ private:
     unsigned int m_Width, m_Height;
     unsigned int m_IntermediateBufferID;
     unsigned int m_MultiSampledBufferID;
+    unsigned int m_MultiSampledRenderBufferID;
     std::shared_ptr<Texture2D> m_DisplayedColorTexture;
     std::shared_ptr<Texture2D> m_MultiSampledColorTexture;
 };
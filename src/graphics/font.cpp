@@ -1,13 +1,18 @@
 #include "font.h"
 
+#include <vector>
+#include <cstring>
+
 #include <ft2build.h>
 #include FT_FREETYPE_H
 
 #include <glad/glad.h>
 
 #include "core/logger.h"
+#include "graphics/graphics_context.h"
 
 Font::Font(const std::string& filepath)
+    : m_Characters()
 {
     FT_Library ft;
     if (FT_Init_FreeType(&ft))
@@ -20,13 +25,19 @@ Font::Font(const std::string& filepath)
     if (FT_New_Face(ft, filepath.c_str(), 0, &face))
     {
         LOG_ERROR("Freetype: Failed to load font at {0}", filepath);
+        FT_Done_FreeType(ft);
+        return;
     }
 
-    FT_Set_Pixel_Sizes(face, 128, 128);
+    FT_Set_Pixel_Sizes(face, FONT_PIXEL_SIZE, FONT_PIXEL_SIZE);
 
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    // Glyphs are placed left to right in rows, the atlas height is known once all of them are placed
+    std::array<std::vector<unsigned char>, FONT_GLYPH_COUNT> bitmaps;
+    std::array<glm::ivec2, FONT_GLYPH_COUNT> offsets;
+    glm::ivec2 pen = { FONT_ATLAS_PADDING, FONT_ATLAS_PADDING };
+    int rowHeight = 0;
 
-    for (unsigned char c = 0; c < 128; c++)
+    for (unsigned char c = 0; c < FONT_GLYPH_COUNT; c++)
     {
         if (FT_Load_Char(face, c, FT_LOAD_RENDER))
         {
@@ -34,26 +45,79 @@ Font::Font(const std::string& filepath)
             continue;
         }
 
-        TextureData data = {
-            { face->glyph->bitmap.width, face->glyph->bitmap.rows },
-            face->glyph->bitmap.buffer,
-            1u,
-            TextureWrap::CLAMP_TO_EDGE,
-            TextureWrap::CLAMP_TO_EDGE
-        };
+        const FT_Bitmap& bitmap = face->glyph->bitmap;
+        glm::ivec2 size = { bitmap.width, bitmap.rows };
+
+        if (pen.x + size.x + FONT_ATLAS_PADDING > FONT_ATLAS_WIDTH)
+        {
+            pen.x = FONT_ATLAS_PADDING;
+            pen.y += rowHeight + FONT_ATLAS_PADDING;
+            rowHeight = 0;
+        }
 
-        auto texture = std::make_shared<Texture2D>(data);
+        bitmaps[c].resize(size.x * size.y);
+        for (int row = 0; row < size.y; row++)
+            std::memcpy(bitmaps[c].data() + row * size.x, bitmap.buffer + row * bitmap.pitch, size.x);
 
-        Character character = {
-            texture,
-            glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows),
+        offsets[c] = pen;
+        m_Characters[c] = {
+            size,
             glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top),
             static_cast<unsigned int>(face->glyph->advance.x)
         };
 
-        m_Characters.insert({c, character});
+        pen.x += size.x + FONT_ATLAS_PADDING;
+        rowHeight = glm::max(rowHeight, size.y);
     }
 
     FT_Done_Face(face);
     FT_Done_FreeType(ft);
+
+    int atlasHeight = pen.y + rowHeight + FONT_ATLAS_PADDING;
+    std::vector<unsigned char> atlas(FONT_ATLAS_WIDTH * atlasHeight, 0);
+
+    for (int c = 0; c < FONT_GLYPH_COUNT; c++)
+    {
+        Character& character = m_Characters[c];
+        for (int row = 0; row < character.Size.y; row++)
+        {
+            std::memcpy(
+                atlas.data() + (offsets[c].y + row) * FONT_ATLAS_WIDTH + offsets[c].x,
+                bitmaps[c].data() + row * character.Size.x,
+                character.Size.x
+            );
+        }
+
+        // Bitmap rows are stored top to bottom, so the bottom of the glyph has the larger v coordinate
+        character.TexCoordBottomLeft = {
+            (float)offsets[c].x / FONT_ATLAS_WIDTH,
+            (float)(offsets[c].y + character.Size.y) / atlasHeight
+        };
+        character.TexCoordTopRight = {
+            (float)(offsets[c].x + character.Size.x) / FONT_ATLAS_WIDTH,
+            (float)offsets[c].y / atlasHeight
+        };
+    }
+
+    if (GraphicsContext::IsAvailable())
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    TextureData data = {
+        { FONT_ATLAS_WIDTH, atlasHeight },
+        atlas.data(),
+        1u,
+        TextureWrap::CLAMP_TO_EDGE,
+        TextureWrap::CLAMP_TO_EDGE
+    };
+    data.IsAlphaMask = true;
+
+    m_Atlas = std::make_shared<Texture2D>(data);
+}
+
+const Font::Character& Font::GetCharacter(char c) const
+{
+    static const Character missingCharacter = {};
+
+    unsigned char index = static_cast<unsigned char>(c);
+    return index < FONT_GLYPH_COUNT ? m_Characters[index] : missingCharacter;
 }
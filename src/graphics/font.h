@@ -1,13 +1,22 @@
 #pragma once
 
+#include <array>
 #include <memory>
 #include <string>
-#include <unordered_map>
 
 #include <glm/glm.hpp>
 
 #include "graphics/texture.h"
 
+// number of ASCII glyphs loaded from each font
+#define FONT_GLYPH_COUNT 128
+// pixel height glyphs are rasterized at
+#define FONT_PIXEL_SIZE 128
+// width of the glyph atlas, rows of glyphs are added until all of them fit
+#define FONT_ATLAS_WIDTH 2048
+// empty pixels kept around each glyph in the atlas to avoid bleeding when filtering
+#define FONT_ATLAS_PADDING 2
+
 class Font
 {
 public:
@@ -15,14 +24,17 @@ public:
     ~Font() = default;
 
     struct Character {
-        std::shared_ptr<Texture2D> Texture;
         glm::ivec2 Size;
         glm::ivec2 Bearing;
         unsigned int Advance;
+        glm::vec2 TexCoordBottomLeft;
+        glm::vec2 TexCoordTopRight;
     };
 
-    inline std::unordered_map<char, Character>& GetCharacters() { return m_Characters; }
+    const Character& GetCharacter(char c) const;
+    inline const std::shared_ptr<Texture2D>& GetAtlas() const { return m_Atlas; }
 
 private:
-    std::unordered_map<char, Character> m_Characters;
+    std::array<Character, FONT_GLYPH_COUNT> m_Characters;
+    std::shared_ptr<Texture2D> m_Atlas;
 };
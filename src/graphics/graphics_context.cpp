@@ -1,7 +1,12 @@
 #include "graphics_context.h"
 
+#include <string>
+
 #include "core/logger.h"
 
+bool GraphicsContext::s_SoftwareRenderer = false;
+bool GraphicsContext::s_Available = false;
+
 GraphicsContext::GraphicsContext(GLFWwindow* glfwWindow)
     : m_GLFWwindow(glfwWindow)
 {
@@ -14,12 +19,21 @@ void GraphicsContext::Init()
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
     {
         LOG_CRITICAL("Failed to initialize GLAD");
+        return;
     }
 
+    s_Available = true;
+
     LOG_INFO("Graphics Info:");
     LOG_INFO("  Vendor: {0}", reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
     LOG_INFO("  Renderer: {0}", reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
     LOG_INFO("  Version: {0}", reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+
+    std::string renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+    s_SoftwareRenderer = renderer.find("llvmpipe") != std::string::npos ||
+                         renderer.find("softpipe") != std::string::npos ||
+                         renderer.find("SwiftShader") != std::string::npos ||
+                         renderer.find("Software") != std::string::npos;
 }
 
 void GraphicsContext::SwapBuffers()
@@ -12,6 +12,13 @@ public:
     void Init();
     void SwapBuffers();
 
+    // Whether the driver rasterizes on the CPU (llvmpipe, softpipe, SwiftShader), where heavy fragment shaders are best avoided
+    static bool IsSoftwareRenderer() { return s_SoftwareRenderer; }
+    // Whether GL has been loaded. Without it resources are created without GL objects, so frames can be recorded headless.
+    static bool IsAvailable() { return s_Available; }
+
 private:
     GLFWwindow* m_GLFWwindow;
+    static bool s_SoftwareRenderer;
+    static bool s_Available;
 };
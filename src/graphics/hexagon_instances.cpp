@@ -0,0 +1,65 @@
+#include "hexagon_instances.h"
+
+#include "util/util.h"
+#include "core/logger.h"
+
+HexagonInstances::HexagonInstances(unsigned int initialCapacity)
+    : m_Capacity(initialCapacity), m_Dirty(false)
+{
+    m_Instances.reserve(m_Capacity);
+}
+
+void HexagonInstances::Clear()
+{
+    m_Instances.clear();
+    m_Dirty = true;
+}
+
+void HexagonInstances::Add(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color, std::optional<float> borderThickness)
+{
+    float borderRatio = 0.0f;
+    if (borderThickness.has_value())
+    {
+        float thickness = borderThickness.value();
+        if (thickness < 0.0f || thickness > 100.0f)
+        {
+            LOG_WARN("HexagonInstances::Add: borderThickness parameter outside of 0-100 bound");
+            thickness = Util::Clamp<float>(thickness, 0.0f, 100.0f);
+        }
+
+        borderRatio = (100.0f - thickness) / 100.0f;
+    }
+
+    m_Instances.push_back({ position, size, color, borderRatio });
+    m_Dirty = true;
+}
+
+void HexagonInstances::Upload(const std::shared_ptr<VertexArray>& hexagonVertexArray)
+{
+    if (!m_VertexArray)
+    {
+        // Shares the hexagon geometry of the renderer, only the per-instance attributes are owned here
+        std::vector<int> hexagonLayout = {3};
+        m_VertexArray = std::make_shared<VertexArray>(hexagonVertexArray->GetVertexBuffer(), hexagonVertexArray->GetIndexBuffer(), hexagonLayout);
+
+        std::vector<int> instanceLayout = {2, 2, 4, 1};
+        m_InstanceBuffer = std::make_shared<VertexBuffer>(nullptr, m_Capacity * sizeof(HexagonInstance), GL_DYNAMIC_DRAW);
+        m_VertexArray->SetInstanceBuffer(m_InstanceBuffer, instanceLayout);
+    }
+
+    if (!m_Dirty)
+        return;
+
+    m_InstanceBuffer->Bind();
+
+    if (m_Instances.size() > m_Capacity)
+    {
+        m_Capacity = glm::max<unsigned int>(m_Capacity * 2, m_Instances.size());
+        m_InstanceBuffer->SetData(nullptr, m_Capacity * sizeof(HexagonInstance));
+    }
+
+    if (!m_Instances.empty())
+        m_InstanceBuffer->UpdateData((float*)m_Instances.data(), 0, m_Instances.size() * sizeof(HexagonInstance));
+
+    m_Dirty = false;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <optional>
+
+#include <glm/glm.hpp>
+
+#include "graphics/vertex_array.h"
+
+// number of hexagons the instance buffer is allocated for at construction, grown on demand
+#define INITIAL_HEXAGON_INSTANCE_CAPACITY 1024
+
+struct HexagonInstance
+{
+    glm::vec2 Position;
+    glm::vec2 Size;
+    glm::vec4 Color;
+    float BorderRatio;
+};
+
+// Retained set of hexagons drawn with a single instanced draw call.
+// GPU buffers are created on the first upload, after that instances are only uploaded once they have been modified.
+class HexagonInstances
+{
+public:
+    HexagonInstances(unsigned int initialCapacity = INITIAL_HEXAGON_INSTANCE_CAPACITY);
+    ~HexagonInstances() = default;
+
+    void Clear();
+    void Add(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color,
+             std::optional<float> borderThickness = std::nullopt);
+    void Upload(const std::shared_ptr<VertexArray>& hexagonVertexArray);
+
+    inline unsigned int GetCount() const { return m_Instances.size(); }
+    inline const std::shared_ptr<VertexArray>& GetVertexArray() const { return m_VertexArray; }
+
+private:
+    std::vector<HexagonInstance> m_Instances;
+    std::shared_ptr<VertexBuffer> m_InstanceBuffer;
+    std::shared_ptr<VertexArray> m_VertexArray;
+    unsigned int m_Capacity;
+    bool m_Dirty;
+};
@@ -0,0 +1,290 @@
+#include "render_backend.h"
+
+#include <glad/glad.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "core/logger.h"
+#include "core/resource_manager.h"
+#include "graphics/renderer.h"
+#include "graphics/render_state.h"
+#include "graphics/hexagon_instances.h"
+
+GLRenderBackend::GLRenderBackend()
+    : m_QuadBatchCapacity(0), m_SavedViewport{0, 0, 0, 0}
+{
+    RenderState::SetCapability(GL_MULTISAMPLE, true);
+    RenderState::SetCapability(GL_BLEND, true);
+    RenderState::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    float hexagonVertices[6 * 3];
+    for (int i = 0; i < 6; i++)
+    {
+        hexagonVertices[i * 3 + 0] = Renderer2D::s_HexagonOutline[i].x;
+        hexagonVertices[i * 3 + 1] = Renderer2D::s_HexagonOutline[i].y;
+        hexagonVertices[i * 3 + 2] = 0.0f;
+    }
+
+    unsigned int hexagonIndices[4 * 3] = {
+        0, 2, 1,
+        0, 3, 2,
+        0, 5, 3,
+        5, 4, 3
+    };
+
+    std::vector<int> hexagonLayout = {3};
+    auto hexagonVB = std::make_shared<VertexBuffer>(hexagonVertices, sizeof(hexagonVertices));
+    auto hexagonIB = std::make_shared<IndexBuffer>(hexagonIndices, sizeof(hexagonIndices) / sizeof(unsigned int));
+    m_HexagonVertexArray = std::make_shared<VertexArray>(hexagonVB, hexagonIB, hexagonLayout);
+
+    std::vector<int> quadBatchLayout = {3, 4, 2, 1};
+    auto quadBatchVB = std::make_shared<VertexBuffer>(nullptr, 0, GL_DYNAMIC_DRAW);
+    auto quadBatchIB = std::make_shared<IndexBuffer>(nullptr, 0);
+    m_QuadBatchVertexArray = std::make_shared<VertexArray>(quadBatchVB, quadBatchIB, quadBatchLayout);
+    GrowQuadBatch(INITIAL_QUAD_BATCH_CAPACITY);
+
+    static unsigned char whitePixel[4] = { 0xFF, 0xFF, 0xFF, 0xFF };
+    TextureData whiteTextureData = { { 1, 1 }, whitePixel, 4u };
+    m_WhiteTexture = std::make_shared<Texture2D>(whiteTextureData);
+
+    m_FlatColorShader = ResourceManager::GetShader("color");
+    m_QuadBatchShader = ResourceManager::GetShader("quad");
+    m_HexagonInstanceShader = ResourceManager::GetShader("hexagon");
+
+    m_FlatColorModelUniform = m_FlatColorShader->GetUniform<glm::mat4>("u_Model");
+    m_FlatColorColorUniform = m_FlatColorShader->GetUniform<glm::vec4>("u_Color");
+
+    m_FrameUniformBuffer = std::make_shared<UniformBuffer>(sizeof(FrameData), FRAME_DATA_BINDING);
+
+    int samplers[MAX_TEXTURE_SLOTS];
+    for (int i = 0; i < MAX_TEXTURE_SLOTS; i++)
+        samplers[i] = i;
+
+    m_QuadBatchShader->Bind();
+    m_QuadBatchShader->SetIntArray("u_Textures", samplers, MAX_TEXTURE_SLOTS);
+}
+
+void GLRenderBackend::Execute(const RenderCommandList& commandList)
+{
+    for (const auto& command : commandList.GetCommands())
+    {
+        switch (command.Type)
+        {
+            case RenderCommandType::CLEAR:
+            {
+                const glm::vec4& color = commandList.GetDrawParams()[command.Data].Params.Color;
+                glClearColor(color.r, color.g, color.b, color.a);
+                glClear(GL_COLOR_BUFFER_BIT);
+                break;
+            }
+            case RenderCommandType::SET_FRAME_DATA:
+                m_FrameUniformBuffer->SetData(&commandList.GetFrameData()[command.Data], sizeof(FrameData));
+                break;
+            case RenderCommandType::SET_CLIP_RECT:
+            {
+                const glm::ivec4& rect = commandList.GetClipRects()[command.Data];
+                RenderState::SetCapability(GL_SCISSOR_TEST, true);
+                glScissor(rect.x, rect.y, rect.z, rect.w);
+                break;
+            }
+            case RenderCommandType::RESET_CLIP_RECT:
+                RenderState::SetCapability(GL_SCISSOR_TEST, false);
+                break;
+            case RenderCommandType::SET_BLEND_MODE:
+                if ((BlendMode)command.Data == BlendMode::ACCUMULATE_ALPHA)
+                    RenderState::SetBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+                else
+                    RenderState::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                break;
+            case RenderCommandType::BEGIN_RENDER_TARGET:
+                BeginRenderTarget(commandList, command);
+                break;
+            case RenderCommandType::END_RENDER_TARGET:
+                EndRenderTarget(commandList, command);
+                break;
+            case RenderCommandType::DRAW_QUADS:
+                DrawQuads(commandList, command);
+                break;
+            case RenderCommandType::DRAW_HEXAGON_INSTANCES:
+                DrawHexagonInstances(commandList, command);
+                break;
+            case RenderCommandType::DRAW_HEXAGON:
+                DrawHexagon(commandList, command);
+                break;
+            case RenderCommandType::DRAW_GEOMETRY:
+                DrawGeometry(commandList, command);
+                break;
+            default:
+                LOG_WARN("GLRenderBackend::Execute: unknown render command type {0}", (int)command.Type);
+                break;
+        }
+    }
+}
+
+void GLRenderBackend::BeginRenderTarget(const RenderCommandList& commandList, const RenderCommand& command)
+{
+    const auto& frameBuffer = commandList.GetFrameBuffers()[command.Resource];
+    const glm::uvec2& viewportSize = commandList.GetViewportSizes()[command.Data];
+
+    glGetIntegerv(GL_VIEWPORT, m_SavedViewport);
+
+    if (viewportSize.x > 0 && viewportSize.y > 0)
+        frameBuffer->Bind(viewportSize.x, viewportSize.y);
+    else
+        frameBuffer->Bind();
+}
+
+void GLRenderBackend::EndRenderTarget(const RenderCommandList& commandList, const RenderCommand& command)
+{
+    const auto& frameBuffer = commandList.GetFrameBuffers()[command.Resource];
+
+    if (command.TextureCount > 0)
+        frameBuffer->ResolveInto(*commandList.GetTextures()[command.FirstTexture]);
+    else
+        frameBuffer->PostProcess();
+
+    frameBuffer->Unbind();
+    glViewport(m_SavedViewport[0], m_SavedViewport[1], m_SavedViewport[2], m_SavedViewport[3]);
+}
+
+void GLRenderBackend::DrawQuads(const RenderCommandList& commandList, const RenderCommand& command)
+{
+    if (command.Count > m_QuadBatchCapacity)
+        GrowQuadBatch(command.Count);
+
+    m_QuadBatchVertexArray->Bind();
+
+    const auto& vertexBuffer = m_QuadBatchVertexArray->GetVertexBuffer();
+    vertexBuffer->Bind();
+    vertexBuffer->UpdateData((float*)&commandList.GetQuadVertices()[command.Data], 0, command.Count * 4 * sizeof(QuadVertex));
+
+    // Untextured quads reference the empty texture slot, sampled as plain white
+    for (unsigned int i = 0; i < command.TextureCount; i++)
+    {
+        const auto& texture = commandList.GetTextures()[command.FirstTexture + i];
+        (texture ? texture : m_WhiteTexture)->Bind(i);
+    }
+
+    m_QuadBatchShader->Bind();
+    glDrawElements(GL_TRIANGLES, command.Count * 6, GL_UNSIGNED_INT, nullptr);
+}
+
+void GLRenderBackend::DrawHexagonInstances(const RenderCommandList& commandList, const RenderCommand& command)
+{
+    const auto& instances = commandList.GetHexagonInstances()[command.Resource];
+    instances->Upload(m_HexagonVertexArray);
+
+    const auto& vertexArray = instances->GetVertexArray();
+    vertexArray->Bind();
+
+    for (unsigned int i = 0; i < command.TextureCount; i++)
+        commandList.GetTextures()[command.FirstTexture + i]->Bind(i);
+
+    // Instances without their own shader are drawn as flat colored hexagons
+    const auto& shader = commandList.GetShaders()[command.Data];
+    (shader ? shader : m_HexagonInstanceShader)->Bind();
+
+    glDrawElementsInstanced(GL_TRIANGLES, vertexArray->GetIndexBuffer()->GetIndexCount(), GL_UNSIGNED_INT, nullptr, command.Count);
+}
+
+void GLRenderBackend::DrawHexagon(const RenderCommandList& commandList, const RenderCommand& command)
+{
+    const auto& shader = commandList.GetShaders()[command.Resource];
+    const DrawParams& drawParams = commandList.GetDrawParams()[command.Data];
+
+    m_HexagonVertexArray->Bind();
+
+    shader->Bind();
+    shader->SetModel(drawParams.Model);
+    shader->SetParams(drawParams.Params);
+
+    glDrawElements(GL_TRIANGLES, m_HexagonVertexArray->GetIndexBuffer()->GetIndexCount(), GL_UNSIGNED_INT, nullptr);
+}
+
+void GLRenderBackend::DrawGeometry(const RenderCommandList& commandList, const RenderCommand& command)
+{
+    const auto& vertexArray = commandList.GetVertexArrays()[command.Resource];
+    const DrawParams& drawParams = commandList.GetDrawParams()[command.Data];
+
+    vertexArray->Bind();
+    m_FlatColorShader->Bind();
+
+    m_FlatColorShader->Set(m_FlatColorModelUniform, drawParams.Model);
+    m_FlatColorShader->Set(m_FlatColorColorUniform, drawParams.Params.Color);
+    glDrawElements(GL_TRIANGLES, vertexArray->GetIndexBuffer()->GetIndexCount(), GL_UNSIGNED_INT, nullptr);
+}
+
+void GLRenderBackend::GrowQuadBatch(unsigned int quadCount)
+{
+    unsigned int capacity = glm::max(m_QuadBatchCapacity * 2, quadCount);
+
+    std::vector<unsigned int> indices(capacity * 6);
+    for (unsigned int i = 0, offset = 0; i < capacity * 6; i += 6, offset += 4)
+    {
+        indices[i + 0] = offset + 0;
+        indices[i + 1] = offset + 2;
+        indices[i + 2] = offset + 3;
+        indices[i + 3] = offset + 0;
+        indices[i + 4] = offset + 1;
+        indices[i + 5] = offset + 2;
+    }
+
+    // Element buffer binding is part of the vertex array state
+    m_QuadBatchVertexArray->Bind();
+    m_QuadBatchVertexArray->GetVertexBuffer()->Bind();
+    m_QuadBatchVertexArray->GetVertexBuffer()->SetData(nullptr, capacity * 4 * sizeof(QuadVertex));
+    m_QuadBatchVertexArray->GetIndexBuffer()->SetData(indices.data(), capacity * 6);
+
+    m_QuadBatchCapacity = capacity;
+}
+
+void NullRenderBackend::Execute(const RenderCommandList& commandList)
+{
+    for (const auto& command : commandList.GetCommands())
+    {
+        if (command.Type >= RenderCommandType::DRAW_QUADS)
+            m_DrawCount++;
+        if (command.Type == RenderCommandType::DRAW_QUADS)
+            m_QuadCount += command.Count;
+
+        m_Commands.push_back(command);
+    }
+}
+
+void NullRenderBackend::Reset()
+{
+    m_Commands.clear();
+    m_DrawCount = 0;
+    m_QuadCount = 0;
+}
+
+unsigned int NullRenderBackend::GetCommandCount(RenderCommandType type) const
+{
+    unsigned int count = 0;
+    for (const auto& command : m_Commands)
+    {
+        if (command.Type == type)
+            count++;
+    }
+
+    return count;
+}
+
+int NullRenderBackend::FindFirstDifference(const NullRenderBackend& other) const
+{
+    // Resource and data indices are local to the list a command was recorded into, so they are not compared.
+    // Sort keys are built from resource handles rather than GL names, they match between runs with and without a context.
+    size_t commonCount = glm::min(m_Commands.size(), other.m_Commands.size());
+    for (size_t i = 0; i < commonCount; i++)
+    {
+        const RenderCommand& a = m_Commands[i];
+        const RenderCommand& b = other.m_Commands[i];
+        if (a.Type != b.Type || a.SortKey != b.SortKey || a.Count != b.Count || a.TextureCount != b.TextureCount)
+            return (int)i;
+    }
+
+    if (m_Commands.size() != other.m_Commands.size())
+        return (int)commonCount;
+
+    return -1;
+}
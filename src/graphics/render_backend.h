@@ -0,0 +1,86 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "graphics/shader.h"
+#include "graphics/buffer.h"
+#include "graphics/texture.h"
+#include "graphics/vertex_array.h"
+#include "graphics/render_command.h"
+
+// number of texture units sampled by the batched quad shader (must match quad.glsl)
+#define MAX_TEXTURE_SLOTS 16
+// number of quads the batch buffers are allocated for at startup, grown on demand
+#define INITIAL_QUAD_BATCH_CAPACITY 1000
+
+// Executes command lists recorded by Renderer2D
+class RenderBackend
+{
+public:
+    virtual ~RenderBackend() = default;
+
+    virtual void Execute(const RenderCommandList& commandList) = 0;
+};
+
+// Issues the commands to OpenGL, owns every GPU resource the commands are drawn with
+class GLRenderBackend : public RenderBackend
+{
+public:
+    GLRenderBackend();
+    ~GLRenderBackend() = default;
+
+    virtual void Execute(const RenderCommandList& commandList) override;
+
+private:
+    void BeginRenderTarget(const RenderCommandList& commandList, const RenderCommand& command);
+    void EndRenderTarget(const RenderCommandList& commandList, const RenderCommand& command);
+    void DrawQuads(const RenderCommandList& commandList, const RenderCommand& command);
+    void DrawHexagonInstances(const RenderCommandList& commandList, const RenderCommand& command);
+    void DrawHexagon(const RenderCommandList& commandList, const RenderCommand& command);
+    void DrawGeometry(const RenderCommandList& commandList, const RenderCommand& command);
+    void GrowQuadBatch(unsigned int quadCount);
+
+private:
+    std::shared_ptr<VertexArray> m_HexagonVertexArray;
+    std::shared_ptr<Shader> m_FlatColorShader;
+    std::shared_ptr<Shader> m_HexagonInstanceShader;
+
+    std::shared_ptr<VertexArray> m_QuadBatchVertexArray;
+    std::shared_ptr<Shader> m_QuadBatchShader;
+    std::shared_ptr<Texture2D> m_WhiteTexture;
+    unsigned int m_QuadBatchCapacity;
+
+    Uniform<glm::mat4> m_FlatColorModelUniform;
+    Uniform<glm::vec4> m_FlatColorColorUniform;
+
+    std::shared_ptr<UniformBuffer> m_FrameUniformBuffer;
+
+    // viewport of the default framebuffer, restored once a render target ends
+    int m_SavedViewport[4];
+};
+
+// Draws nothing and needs no OpenGL context, only keeps what it was asked to execute,
+// so the draws of a frame can be counted and compared against another frame or run.
+class NullRenderBackend : public RenderBackend
+{
+public:
+    NullRenderBackend() = default;
+    ~NullRenderBackend() = default;
+
+    virtual void Execute(const RenderCommandList& commandList) override;
+    void Reset();
+
+    unsigned int GetCommandCount(RenderCommandType type) const;
+    // index of the first command that differs in type, sort key or size from the ones executed by other, -1 if there is none
+    int FindFirstDifference(const NullRenderBackend& other) const;
+
+    inline const std::vector<RenderCommand>& GetCommands() const { return m_Commands; }
+    inline unsigned int GetDrawCount() const { return m_DrawCount; }
+    inline unsigned int GetQuadCount() const { return m_QuadCount; }
+
+private:
+    std::vector<RenderCommand> m_Commands;
+    unsigned int m_DrawCount = 0;
+    unsigned int m_QuadCount = 0;
+};
@@ -0,0 +1,254 @@
+#include "render_command.h"
+
+#include "graphics/hexagon_instances.h"
+
+void RenderCommandList::Reset()
+{
+    m_Commands.clear();
+    m_SortBuffer.clear();
+
+    m_QuadVertices.clear();
+    m_Textures.clear();
+    m_FrameData.clear();
+    m_DrawParams.clear();
+    m_ClipRects.clear();
+    m_ViewportSizes.clear();
+
+    m_Shaders.clear();
+    m_VertexArrays.clear();
+    m_HexagonInstances.clear();
+    m_FrameBuffers.clear();
+}
+
+void RenderCommandList::Sort()
+{
+    if (m_Commands.size() < 2)
+        return;
+
+    m_SortBuffer.resize(m_Commands.size());
+
+    // Least significant byte first, every pass is a stable counting sort
+    for (unsigned int shift = 0; shift < 64; shift += 8)
+    {
+        unsigned int offsets[256] = {};
+        for (const auto& command : m_Commands)
+            offsets[(command.SortKey >> shift) & 0xFF]++;
+
+        // Most key bytes are shared by every command, such passes would not move anything
+        if (offsets[(m_Commands[0].SortKey >> shift) & 0xFF] == m_Commands.size())
+            continue;
+
+        unsigned int offset = 0;
+        for (unsigned int i = 0; i < 256; i++)
+        {
+            unsigned int count = offsets[i];
+            offsets[i] = offset;
+            offset += count;
+        }
+
+        for (const auto& command : m_Commands)
+            m_SortBuffer[offsets[(command.SortKey >> shift) & 0xFF]++] = command;
+
+        m_Commands.swap(m_SortBuffer);
+    }
+}
+
+void RenderCommandList::Append(const RenderCommandList& other)
+{
+    m_Commands.reserve(m_Commands.size() + other.m_Commands.size());
+
+    for (RenderCommand command : other.m_Commands)
+    {
+        switch (command.Type)
+        {
+            case RenderCommandType::CLEAR:
+                command.Data += m_DrawParams.size();
+                break;
+            case RenderCommandType::SET_FRAME_DATA:
+                command.Data += m_FrameData.size();
+                break;
+            case RenderCommandType::SET_CLIP_RECT:
+                command.Data += m_ClipRects.size();
+                break;
+            case RenderCommandType::BEGIN_RENDER_TARGET:
+                command.Resource += m_FrameBuffers.size();
+                command.Data += m_ViewportSizes.size();
+                break;
+            case RenderCommandType::END_RENDER_TARGET:
+                command.Resource += m_FrameBuffers.size();
+                command.FirstTexture += m_Textures.size();
+                break;
+            case RenderCommandType::DRAW_QUADS:
+                command.Data += m_QuadVertices.size();
+                command.FirstTexture += m_Textures.size();
+                break;
+            case RenderCommandType::DRAW_HEXAGON_INSTANCES:
+                command.Resource += m_HexagonInstances.size();
+                command.Data += m_Shaders.size();
+                command.FirstTexture += m_Textures.size();
+                break;
+            case RenderCommandType::DRAW_HEXAGON:
+                command.Resource += m_Shaders.size();
+                command.Data += m_DrawParams.size();
+                break;
+            case RenderCommandType::DRAW_GEOMETRY:
+                command.Resource += m_VertexArrays.size();
+                command.Data += m_DrawParams.size();
+                break;
+            default:
+                break;
+        }
+
+        m_Commands.push_back(command);
+    }
+
+    m_QuadVertices.insert(m_QuadVertices.end(), other.m_QuadVertices.begin(), other.m_QuadVertices.end());
+    m_Textures.insert(m_Textures.end(), other.m_Textures.begin(), other.m_Textures.end());
+    m_FrameData.insert(m_FrameData.end(), other.m_FrameData.begin(), other.m_FrameData.end());
+    m_DrawParams.insert(m_DrawParams.end(), other.m_DrawParams.begin(), other.m_DrawParams.end());
+    m_ClipRects.insert(m_ClipRects.end(), other.m_ClipRects.begin(), other.m_ClipRects.end());
+    m_ViewportSizes.insert(m_ViewportSizes.end(), other.m_ViewportSizes.begin(), other.m_ViewportSizes.end());
+
+    m_Shaders.insert(m_Shaders.end(), other.m_Shaders.begin(), other.m_Shaders.end());
+    m_VertexArrays.insert(m_VertexArrays.end(), other.m_VertexArrays.begin(), other.m_VertexArrays.end());
+    m_HexagonInstances.insert(m_HexagonInstances.end(), other.m_HexagonInstances.begin(), other.m_HexagonInstances.end());
+    m_FrameBuffers.insert(m_FrameBuffers.end(), other.m_FrameBuffers.begin(), other.m_FrameBuffers.end());
+}
+
+RenderCommand& RenderCommandList::PushCommand(RenderCommandType type, uint64_t sortKey)
+{
+    RenderCommand command = {};
+    command.Type = type;
+    command.SortKey = sortKey;
+
+    m_Commands.push_back(command);
+    return m_Commands.back();
+}
+
+void RenderCommandList::SubmitClear(const glm::vec4& color, uint64_t sortKey)
+{
+    DrawParams drawParams = {};
+    drawParams.Params.Color = color;
+
+    RenderCommand& command = PushCommand(RenderCommandType::CLEAR, sortKey);
+    command.Data = m_DrawParams.size();
+    m_DrawParams.push_back(drawParams);
+}
+
+void RenderCommandList::SubmitFrameData(const FrameData& frameData, uint64_t sortKey)
+{
+    RenderCommand& command = PushCommand(RenderCommandType::SET_FRAME_DATA, sortKey);
+    command.Data = m_FrameData.size();
+    m_FrameData.push_back(frameData);
+}
+
+void RenderCommandList::SubmitClipRect(const glm::ivec4& rect, uint64_t sortKey)
+{
+    RenderCommand& command = PushCommand(RenderCommandType::SET_CLIP_RECT, sortKey);
+    command.Data = m_ClipRects.size();
+    m_ClipRects.push_back(rect);
+}
+
+void RenderCommandList::SubmitResetClipRect(uint64_t sortKey)
+{
+    PushCommand(RenderCommandType::RESET_CLIP_RECT, sortKey);
+}
+
+void RenderCommandList::SubmitBlendMode(BlendMode mode, uint64_t sortKey)
+{
+    RenderCommand& command = PushCommand(RenderCommandType::SET_BLEND_MODE, sortKey);
+    command.Data = (uint32_t)mode;
+}
+
+void RenderCommandList::SubmitBeginRenderTarget(const std::shared_ptr<FrameBuffer>& frameBuffer, const glm::uvec2& viewportSize,
+                                                uint64_t sortKey)
+{
+    RenderCommand& command = PushCommand(RenderCommandType::BEGIN_RENDER_TARGET, sortKey);
+    command.Resource = m_FrameBuffers.size();
+    command.Data = m_ViewportSizes.size();
+
+    m_FrameBuffers.push_back(frameBuffer);
+    m_ViewportSizes.push_back(viewportSize);
+}
+
+// Without a resolve target the framebuffer is resolved into its own texture
+void RenderCommandList::SubmitEndRenderTarget(const std::shared_ptr<FrameBuffer>& frameBuffer, const std::shared_ptr<Texture2D>& resolveTarget,
+                                              uint64_t sortKey)
+{
+    RenderCommand& command = PushCommand(RenderCommandType::END_RENDER_TARGET, sortKey);
+    command.Resource = m_FrameBuffers.size();
+    command.FirstTexture = m_Textures.size();
+    command.TextureCount = resolveTarget ? 1 : 0;
+
+    m_FrameBuffers.push_back(frameBuffer);
+    if (resolveTarget)
+        m_Textures.push_back(resolveTarget);
+}
+
+void RenderCommandList::SubmitQuads(const QuadVertex* vertices, unsigned int quadCount,
+                                    const std::shared_ptr<Texture2D>* textures, unsigned int textureCount, uint64_t sortKey)
+{
+    RenderCommand& command = PushCommand(RenderCommandType::DRAW_QUADS, sortKey);
+    command.Data = m_QuadVertices.size();
+    command.Count = quadCount;
+    command.FirstTexture = m_Textures.size();
+    command.TextureCount = textureCount;
+
+    m_QuadVertices.insert(m_QuadVertices.end(), vertices, vertices + quadCount * 4);
+    m_Textures.insert(m_Textures.end(), textures, textures + textureCount);
+}
+
+void RenderCommandList::SubmitHexagonInstances(const std::shared_ptr<HexagonInstances>& instances, const std::shared_ptr<Shader>& shader,
+                                               const std::shared_ptr<Texture2D>& texture, uint64_t sortKey)
+{
+    RenderCommand& command = PushCommand(RenderCommandType::DRAW_HEXAGON_INSTANCES, sortKey);
+    command.Resource = m_HexagonInstances.size();
+    command.Data = m_Shaders.size();
+    command.Count = instances->GetCount();
+    command.FirstTexture = m_Textures.size();
+    command.TextureCount = texture ? 1 : 0;
+
+    m_HexagonInstances.push_back(instances);
+    m_Shaders.push_back(shader);
+    if (texture)
+        m_Textures.push_back(texture);
+}
+
+void RenderCommandList::SubmitHexagon(const std::shared_ptr<Shader>& shader, const glm::mat4& model, const ShaderParams& params,
+                                      uint64_t sortKey)
+{
+    RenderCommand& command = PushCommand(RenderCommandType::DRAW_HEXAGON, sortKey);
+    command.Resource = m_Shaders.size();
+    command.Data = m_DrawParams.size();
+    command.Count = 1;
+
+    m_Shaders.push_back(shader);
+    m_DrawParams.push_back({ model, params });
+}
+
+void RenderCommandList::SubmitGeometry(const std::shared_ptr<VertexArray>& vertexArray, const glm::mat4& model, const glm::vec4& color,
+                                       uint64_t sortKey)
+{
+    DrawParams drawParams = { model, {} };
+    drawParams.Params.Color = color;
+
+    RenderCommand& command = PushCommand(RenderCommandType::DRAW_GEOMETRY, sortKey);
+    command.Resource = m_VertexArrays.size();
+    command.Data = m_DrawParams.size();
+    command.Count = 1;
+
+    m_VertexArrays.push_back(vertexArray);
+    m_DrawParams.push_back(drawParams);
+}
+
+unsigned int RenderCommandList::GetDrawCount() const
+{
+    unsigned int drawCount = 0;
+    for (const auto& command : m_Commands)
+    {
+        if (command.Type >= RenderCommandType::DRAW_QUADS)
+            drawCount++;
+    }
+
+    return drawCount;
+}
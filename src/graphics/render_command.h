@@ -0,0 +1,143 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "graphics/shader.h"
+#include "graphics/buffer.h"
+#include "graphics/texture.h"
+#include "graphics/vertex_array.h"
+
+class HexagonInstances;
+
+struct QuadVertex
+{
+    glm::vec3 Position;
+    glm::vec4 Color;
+    glm::vec2 TexCoord;
+    float TexIndex;
+};
+
+// CPU side of the FrameData uniform block, laid out according to std140
+struct FrameData
+{
+    glm::mat4 ProjectionView;
+    glm::vec2 ViewportBottomLeft;
+    glm::vec2 PixelsPerUnit;
+    float Time;
+    float Padding[3];
+};
+
+// Per draw state of the commands that do not go through the quad batch
+struct DrawParams
+{
+    glm::mat4 Model;
+    ShaderParams Params;
+};
+
+enum class BlendMode : uint8_t
+{
+    ALPHA            = 0,
+    // source alpha is added to the destination alpha instead of being multiplied by it,
+    // so coverage rendered into a transparent target stays opaque once the target is drawn
+    ACCUMULATE_ALPHA = 1
+};
+
+// Draw commands come last, every type from DRAW_QUADS on is counted as a draw call
+enum class RenderCommandType : uint8_t
+{
+    CLEAR                  = 0,
+    SET_FRAME_DATA         = 1,
+    SET_CLIP_RECT          = 2,
+    RESET_CLIP_RECT        = 3,
+    SET_BLEND_MODE         = 4,
+    BEGIN_RENDER_TARGET    = 5,
+    END_RENDER_TARGET      = 6,
+    DRAW_QUADS             = 7,
+    DRAW_HEXAGON_INSTANCES = 8,
+    DRAW_HEXAGON           = 9,
+    DRAW_GEOMETRY          = 10
+};
+
+// Commands only hold indices into the arrays of the list they were recorded into,
+// so they can be copied, compared and reordered without touching any resource.
+// Sorting by SortKey (see Renderer2D::MakeSortKey) groups commands by layer, then shader, then texture.
+struct RenderCommand
+{
+    uint64_t SortKey;
+    RenderCommandType Type;
+    uint32_t Resource;     // shader, vertex array, hexagon instances or framebuffer of the command
+    uint32_t Data;         // frame data, draw params, clip rect, viewport size, blend mode, first quad vertex or shader of instanced hexagons
+    uint32_t Count;        // number of quads or instances drawn
+    uint32_t FirstTexture;
+    uint32_t TextureCount;
+};
+
+// Stream of draw commands together with the data they refer to.
+// Recorded lists keep their resources alive until they are reset. Contents of buffers and textures
+// are uploaded when they change, so a list executed later draws them as they are at that point.
+class RenderCommandList
+{
+public:
+    RenderCommandList() = default;
+    ~RenderCommandList() = default;
+
+    void Reset();
+    // Stable radix sort of the commands by their sort keys
+    void Sort();
+    // Appends the commands of another list in their current order
+    void Append(const RenderCommandList& other);
+
+    void SubmitClear(const glm::vec4& color, uint64_t sortKey);
+    void SubmitFrameData(const FrameData& frameData, uint64_t sortKey);
+    void SubmitClipRect(const glm::ivec4& rect, uint64_t sortKey);
+    void SubmitResetClipRect(uint64_t sortKey);
+    void SubmitBlendMode(BlendMode mode, uint64_t sortKey);
+    void SubmitBeginRenderTarget(const std::shared_ptr<FrameBuffer>& frameBuffer, const glm::uvec2& viewportSize, uint64_t sortKey);
+    void SubmitEndRenderTarget(const std::shared_ptr<FrameBuffer>& frameBuffer, const std::shared_ptr<Texture2D>& resolveTarget,
+                               uint64_t sortKey);
+    void SubmitQuads(const QuadVertex* vertices, unsigned int quadCount,
+                     const std::shared_ptr<Texture2D>* textures, unsigned int textureCount, uint64_t sortKey);
+    void SubmitHexagonInstances(const std::shared_ptr<HexagonInstances>& instances, const std::shared_ptr<Shader>& shader,
+                                const std::shared_ptr<Texture2D>& texture, uint64_t sortKey);
+    void SubmitHexagon(const std::shared_ptr<Shader>& shader, const glm::mat4& model, const ShaderParams& params, uint64_t sortKey);
+    void SubmitGeometry(const std::shared_ptr<VertexArray>& vertexArray, const glm::mat4& model, const glm::vec4& color,
+                        uint64_t sortKey);
+
+    unsigned int GetDrawCount() const;
+    inline bool IsEmpty() const { return m_Commands.empty(); }
+
+    inline const std::vector<RenderCommand>& GetCommands() const { return m_Commands; }
+    inline const std::vector<QuadVertex>& GetQuadVertices() const { return m_QuadVertices; }
+    inline const std::vector<std::shared_ptr<Texture2D>>& GetTextures() const { return m_Textures; }
+    inline const std::vector<FrameData>& GetFrameData() const { return m_FrameData; }
+    inline const std::vector<DrawParams>& GetDrawParams() const { return m_DrawParams; }
+    inline const std::vector<glm::ivec4>& GetClipRects() const { return m_ClipRects; }
+    inline const std::vector<glm::uvec2>& GetViewportSizes() const { return m_ViewportSizes; }
+    inline const std::vector<std::shared_ptr<Shader>>& GetShaders() const { return m_Shaders; }
+    inline const std::vector<std::shared_ptr<VertexArray>>& GetVertexArrays() const { return m_VertexArrays; }
+    inline const std::vector<std::shared_ptr<HexagonInstances>>& GetHexagonInstances() const { return m_HexagonInstances; }
+    inline const std::vector<std::shared_ptr<FrameBuffer>>& GetFrameBuffers() const { return m_FrameBuffers; }
+
+private:
+    RenderCommand& PushCommand(RenderCommandType type, uint64_t sortKey);
+
+private:
+    std::vector<RenderCommand> m_Commands;
+    std::vector<RenderCommand> m_SortBuffer;
+
+    std::vector<QuadVertex> m_QuadVertices;
+    std::vector<std::shared_ptr<Texture2D>> m_Textures;
+    std::vector<FrameData> m_FrameData;
+    std::vector<DrawParams> m_DrawParams;
+    std::vector<glm::ivec4> m_ClipRects;
+    std::vector<glm::uvec2> m_ViewportSizes;
+
+    std::vector<std::shared_ptr<Shader>> m_Shaders;
+    std::vector<std::shared_ptr<VertexArray>> m_VertexArrays;
+    std::vector<std::shared_ptr<HexagonInstances>> m_HexagonInstances;
+    std::vector<std::shared_ptr<FrameBuffer>> m_FrameBuffers;
+};
@@ -0,0 +1,221 @@
+#include "render_state.h"
+
+#include <array>
+#include <unordered_map>
+
+#include <glad/glad.h>
+
+#include "core/logger.h"
+#include "graphics/graphics_context.h"
+
+// GL default for every binding is 0, the state below starts out matching a fresh context
+struct RenderStateData
+{
+    unsigned int Program = 0;
+    unsigned int VertexArray = 0;
+    unsigned int ArrayBuffer = 0;
+    unsigned int UniformBuffer = 0;
+    unsigned int ActiveTextureUnit = 0;
+    std::array<unsigned int, MAX_TRACKED_TEXTURE_UNITS> Texture2D = {};
+    std::array<unsigned int, MAX_TRACKED_TEXTURE_UNITS> Texture2DMultisample = {};
+    std::unordered_map<unsigned int, bool> Capabilities;
+    unsigned int BlendSourceFactor = GL_ONE;
+    unsigned int BlendDestinationFactor = GL_ZERO;
+    unsigned int BlendSourceAlphaFactor = GL_ONE;
+    unsigned int BlendDestinationAlphaFactor = GL_ZERO;
+
+    RenderState::Statistics Stats;
+};
+
+static RenderStateData s_State;
+
+static bool UpdateBinding(unsigned int& cached, unsigned int value)
+{
+    if (cached == value)
+    {
+        s_State.Stats.Skipped++;
+        return false;
+    }
+
+    cached = value;
+    s_State.Stats.Issued++;
+    return true;
+}
+
+static unsigned int* GetCachedBuffer(unsigned int target)
+{
+    switch (target)
+    {
+        case GL_ARRAY_BUFFER:   return &s_State.ArrayBuffer;
+        case GL_UNIFORM_BUFFER: return &s_State.UniformBuffer;
+        default:                return nullptr;
+    }
+}
+
+static unsigned int* GetCachedTexture(unsigned int unit, unsigned int target)
+{
+    if (unit >= MAX_TRACKED_TEXTURE_UNITS)
+        return nullptr;
+
+    switch (target)
+    {
+        case GL_TEXTURE_2D:             return &s_State.Texture2D[unit];
+        case GL_TEXTURE_2D_MULTISAMPLE: return &s_State.Texture2DMultisample[unit];
+        default:                        return nullptr;
+    }
+}
+
+void RenderState::UseProgram(unsigned int programID)
+{
+    if (!GraphicsContext::IsAvailable())
+        return;
+
+    if (UpdateBinding(s_State.Program, programID))
+    {
+        glUseProgram(programID);
+        s_State.Stats.ProgramChanges++;
+    }
+}
+
+void RenderState::BindVertexArray(unsigned int arrayID)
+{
+    if (!GraphicsContext::IsAvailable())
+        return;
+
+    if (UpdateBinding(s_State.VertexArray, arrayID))
+        glBindVertexArray(arrayID);
+}
+
+// Element array buffer binding is part of the vertex array state, so it is not tracked here
+void RenderState::BindBuffer(unsigned int target, unsigned int bufferID)
+{
+    if (!GraphicsContext::IsAvailable())
+        return;
+
+    unsigned int* cached = GetCachedBuffer(target);
+    if (!cached)
+    {
+        LOG_WARN("RenderState: Buffer target {0} is not tracked", target);
+        glBindBuffer(target, bufferID);
+        return;
+    }
+
+    if (UpdateBinding(*cached, bufferID))
+        glBindBuffer(target, bufferID);
+}
+
+void RenderState::BindTexture(unsigned int unit, unsigned int target, unsigned int textureID)
+{
+    if (!GraphicsContext::IsAvailable())
+        return;
+
+    unsigned int* cached = GetCachedTexture(unit, target);
+    if (cached && *cached == textureID)
+    {
+        s_State.Stats.Skipped++;
+        return;
+    }
+
+    if (UpdateBinding(s_State.ActiveTextureUnit, unit))
+        glActiveTexture(GL_TEXTURE0 + unit);
+
+    if (cached)
+        *cached = textureID;
+
+    glBindTexture(target, textureID);
+    s_State.Stats.Issued++;
+}
+
+void RenderState::SetCapability(unsigned int capability, bool enabled)
+{
+    if (!GraphicsContext::IsAvailable())
+        return;
+
+    auto it = s_State.Capabilities.find(capability);
+    if (it != s_State.Capabilities.end() && it->second == enabled)
+    {
+        s_State.Stats.Skipped++;
+        return;
+    }
+
+    s_State.Capabilities[capability] = enabled;
+    s_State.Stats.Issued++;
+
+    if (enabled)
+        glEnable(capability);
+    else
+        glDisable(capability);
+}
+
+void RenderState::SetBlendFunc(unsigned int sourceFactor, unsigned int destinationFactor)
+{
+    SetBlendFuncSeparate(sourceFactor, destinationFactor, sourceFactor, destinationFactor);
+}
+
+void RenderState::SetBlendFuncSeparate(unsigned int sourceFactor, unsigned int destinationFactor,
+                                       unsigned int sourceAlphaFactor, unsigned int destinationAlphaFactor)
+{
+    if (!GraphicsContext::IsAvailable())
+        return;
+
+    if (s_State.BlendSourceFactor == sourceFactor && s_State.BlendDestinationFactor == destinationFactor &&
+        s_State.BlendSourceAlphaFactor == sourceAlphaFactor && s_State.BlendDestinationAlphaFactor == destinationAlphaFactor)
+    {
+        s_State.Stats.Skipped++;
+        return;
+    }
+
+    s_State.BlendSourceFactor = sourceFactor;
+    s_State.BlendDestinationFactor = destinationFactor;
+    s_State.BlendSourceAlphaFactor = sourceAlphaFactor;
+    s_State.BlendDestinationAlphaFactor = destinationAlphaFactor;
+    s_State.Stats.Issued++;
+
+    glBlendFuncSeparate(sourceFactor, destinationFactor, sourceAlphaFactor, destinationAlphaFactor);
+}
+
+void RenderState::OnProgramDeleted(unsigned int programID)
+{
+    if (s_State.Program == programID)
+        s_State.Program = 0;
+}
+
+void RenderState::OnVertexArrayDeleted(unsigned int arrayID)
+{
+    if (s_State.VertexArray == arrayID)
+        s_State.VertexArray = 0;
+}
+
+void RenderState::OnBufferDeleted(unsigned int bufferID)
+{
+    if (s_State.ArrayBuffer == bufferID)
+        s_State.ArrayBuffer = 0;
+    if (s_State.UniformBuffer == bufferID)
+        s_State.UniformBuffer = 0;
+}
+
+void RenderState::OnTextureDeleted(unsigned int textureID)
+{
+    for (unsigned int unit = 0; unit < MAX_TRACKED_TEXTURE_UNITS; unit++)
+    {
+        if (s_State.Texture2D[unit] == textureID)
+            s_State.Texture2D[unit] = 0;
+        if (s_State.Texture2DMultisample[unit] == textureID)
+            s_State.Texture2DMultisample[unit] = 0;
+    }
+}
+
+unsigned int RenderState::GetActiveTextureUnit()
+{
+    return s_State.ActiveTextureUnit;
+}
+
+const RenderState::Statistics& RenderState::GetStats()
+{
+    return s_State.Stats;
+}
+
+void RenderState::ResetStats()
+{
+    s_State.Stats = Statistics();
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+// number of texture units whose bindings are tracked
+#define MAX_TRACKED_TEXTURE_UNITS 32
+
+// Shadow copy of the GL binding and capability state.
+// Binding an object that is already bound, or toggling a capability to its current value,
+// is skipped instead of being passed on to the driver. Without a context nothing is passed on.
+class RenderState
+{
+public:
+    static void UseProgram(unsigned int programID);
+    static void BindVertexArray(unsigned int arrayID);
+    static void BindBuffer(unsigned int target, unsigned int bufferID);
+    static void BindTexture(unsigned int unit, unsigned int target, unsigned int textureID);
+    static void SetCapability(unsigned int capability, bool enabled);
+    static void SetBlendFunc(unsigned int sourceFactor, unsigned int destinationFactor);
+    static void SetBlendFuncSeparate(unsigned int sourceFactor, unsigned int destinationFactor,
+                                     unsigned int sourceAlphaFactor, unsigned int destinationAlphaFactor);
+
+    // GL hands names of deleted objects out again, so their cached bindings have to be forgotten
+    static void OnProgramDeleted(unsigned int programID);
+    static void OnVertexArrayDeleted(unsigned int arrayID);
+    static void OnBufferDeleted(unsigned int bufferID);
+    static void OnTextureDeleted(unsigned int textureID);
+
+    static unsigned int GetActiveTextureUnit();
+
+    struct Statistics
+    {
+        unsigned int Issued = 0;
+        unsigned int Skipped = 0;
+        unsigned int ProgramChanges = 0;
+    };
+
+    static const Statistics& GetStats();
+    static void ResetStats();
+};
@@ -1,9 +1,6 @@
 #include "renderer.h"
 
-#include <sstream>
-
-#include <glad/glad.h>
-#include <GLFW/glfw3.h>
+#include <algorithm>
 
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -14,95 +11,388 @@
 
 Renderer2D::Renderer2DData* Renderer2D::s_Data = new Renderer2DData();
 
-void Renderer2D::Init()
+const glm::vec2 Renderer2D::s_QuadOutline[4] = {
+    { -0.5f, -0.5f },
+    {  0.5f, -0.5f },
+    {  0.5f,  0.5f },
+    { -0.5f,  0.5f }
+};
+
+const glm::vec2 Renderer2D::s_HexagonOutline[6] = {
+    { -1.0f,  0.0f },
+    { -0.5f,  glm::sqrt(3.0f) / 2.0f },
+    {  0.5f,  glm::sqrt(3.0f) / 2.0f },
+    {  1.0f,  0.0f },
+    {  0.5f, -glm::sqrt(3.0f) / 2.0f },
+    { -0.5f, -glm::sqrt(3.0f) / 2.0f }
+};
+
+void Renderer2D::Init(const std::shared_ptr<RenderBackend>& backend)
 {
-    glEnable(GL_MULTISAMPLE);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glEnable(GL_STENCIL_TEST);
-    glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
+    s_Data->Backend = backend ? backend : std::make_shared<GLRenderBackend>();
+    s_Data->ImmediateCommands = std::make_shared<RenderCommandList>();
+    s_Data->QueuedCommands = std::make_shared<RenderCommandList>();
+}
 
-    float quadVertices[4 * 5] = {
-        -0.5f, -0.5f, 0.0f, 0.0f, 0.0f,
-         0.5f, -0.5f, 0.0f, 1.0f, 0.0f,
-         0.5f,  0.5f, 0.0f, 1.0f, 1.0f,
-        -0.5f,  0.5f, 0.0f, 0.0f, 1.0f
-    };
+void Renderer2D::Shutdown()
+{
+    s_Data->RenderTarget.reset();
+    s_Data->RecordedCommands.reset();
+    s_Data->QueuedCommands.reset();
+    s_Data->ImmediateCommands.reset();
+    s_Data->Backend.reset();
+}
 
-    unsigned int quadIndices[6] = {
-        0, 2, 3,
-        0, 1, 2
-    };
+void Renderer2D::SetTime(float time)
+{
+    s_Data->Time = time;
+}
 
-    std::vector<int> quadLayout = {3, 2};
-    auto quadVB = std::make_shared<VertexBuffer>(quadVertices, sizeof(quadVertices));
-    auto quadIB = std::make_shared<IndexBuffer>(quadIndices, sizeof(quadIndices) / sizeof(unsigned int));
-    s_Data->QuadVertexArray = std::make_shared<VertexArray>(quadVB, quadIB, quadLayout);
+void Renderer2D::BeginScene(const std::shared_ptr<OrthographicCamera>& camera)
+{
+    if (s_Data->Queueing)
+        LOG_WARN("Renderer2D::BeginScene: scene begun inside of a queue, its draws are sorted together with the previous scene");
 
-    float fontVertices[4 * 2] = {
-        0.0f, 0.0f,
-        0.0f, 1.0f,
-        1.0f, 0.0f,
-        1.0f, 1.0f,
-    };
+    // Quads left over from a previous scene still belong to the previous camera
+    Flush();
 
-    unsigned int fontIndices[6] = {
-        0, 1, 2,
-        2, 3, 1
-    };
+    s_Data->Camera = camera;
 
-    std::vector<int> fontLayout = {2};
-    auto fontVB = std::make_shared<VertexBuffer>(fontVertices, sizeof(fontVertices));
-    auto fontIB = std::make_shared<IndexBuffer>(fontIndices, sizeof(fontIndices) / sizeof(unsigned int));
-    s_Data->FontVertexArray = std::make_shared<VertexArray>(fontVB, fontIB, fontLayout);
-
-    float h = glm::sqrt(3) / 2;
-    float hexagonVertices[6 * 3] = {
-        -1.0f, 0.0f, 0.0f,
-        -0.5f,    h, 0.0f,
-         0.5f,    h, 0.0f,
-         1.0f, 0.0f, 0.0f,
-         0.5f,   -h, 0.0f,
-        -0.5f,   -h, 0.0f
-    };
+    // Shared by every shader through the FrameData uniform block
+    FrameData& frameData = s_Data->FrameUniformData;
+    frameData.ProjectionView = camera->GetProjectionViewMatrix();
+    frameData.ViewportBottomLeft = camera->CalculateRelativeBottomLeftPosition();
+    frameData.PixelsPerUnit = camera->ConvertRelativeSizeToPixel(glm::vec2(1.0f));
+    frameData.Time = s_Data->Time;
 
-    unsigned int hexagonIndices[4 * 3] = {
-        0, 2, 1,
-        0, 3, 2,
-        0, 5, 3,
-        5, 4, 3
-    };
+    GetCommandList().SubmitFrameData(frameData, MakeSortKey(s_Data->Layer, 0, 0));
+    ExecuteImmediate();
+}
 
-    std::vector<int> hexagonLayout = {3};
-    auto hexagonVB = std::make_shared<VertexBuffer>(hexagonVertices, sizeof(hexagonVertices));
-    auto hexagonIB = std::make_shared<IndexBuffer>(hexagonIndices, sizeof(hexagonIndices) / sizeof(unsigned int));
-    s_Data->HexagonVertexArray = std::make_shared<VertexArray>(hexagonVB, hexagonIB, hexagonLayout);
+void Renderer2D::EndScene()
+{
+    Flush();
+}
 
-    s_Data->FlatColorShader = ResourceManager::GetShader("color");
-    s_Data->TextureShader = ResourceManager::GetShader("texture");
-    s_Data->FontShader = ResourceManager::GetShader("font");
+void Renderer2D::Flush()
+{
+    if (!s_Data->Queueing)
+    {
+        FlushQuadBatch(s_Data->QuadBatches[0], s_Data->Layer);
+        return;
+    }
+
+    for (unsigned int i = 0; i < RENDER_LAYER_COUNT; i++)
+        FlushQuadBatch(s_Data->QuadBatches[i], (RenderLayer)i);
 }
 
-void Renderer2D::Shutdown()
+void Renderer2D::FlushQuadBatch(QuadBatch& batch, RenderLayer layer)
 {
+    if (batch.Vertices.empty())
+        return;
+
+    // A batch samples up to MAX_TEXTURE_SLOTS textures, so batches of a layer keep their submission order instead
+    unsigned int quadCount = batch.Vertices.size() / 4;
+    GetCommandList().SubmitQuads(batch.Vertices.data(), quadCount, batch.TextureSlots.data(), batch.TextureSlotCount,
+                                 MakeSortKey(layer, 0, 0));
+    s_Data->Stats.DrawCalls++;
+
+    batch.Vertices.clear();
+    for (unsigned int i = 0; i < batch.TextureSlotCount; i++)
+        batch.TextureSlots[i].reset();
+    batch.TextureSlotCount = 0;
+
+    ExecuteImmediate();
 }
 
-void Renderer2D::BeginScene(const std::shared_ptr<OrthographicCamera>& camera)
+// Outside of a queue draws are executed in submission order, so quads batched so far have to go first
+void Renderer2D::FlushUnlessQueued()
 {
-    s_Data->Camera = camera;
+    if (!s_Data->Queueing)
+        Flush();
+}
+
+Renderer2D::QuadBatch& Renderer2D::GetQuadBatch()
+{
+    return s_Data->QuadBatches[s_Data->Queueing ? (size_t)s_Data->Layer : 0];
+}
 
-    s_Data->FlatColorShader->Bind();
-    s_Data->FlatColorShader->SetMat4("u_ProjectionView", camera->GetProjectionViewMatrix());
+// Key layout from the most significant bits: layer (8), shader (16), texture (16), submission order (24)
+uint64_t Renderer2D::MakeSortKey(RenderLayer layer, unsigned int shaderHandle, unsigned int textureHandle)
+{
+    return ((uint64_t)layer << 56) |
+           ((uint64_t)(shaderHandle & 0xFFFF) << 40) |
+           ((uint64_t)(textureHandle & 0xFFFF) << 24) |
+           (uint64_t)(s_Data->SubmissionIndex++ & 0xFFFFFF);
+}
 
-    s_Data->TextureShader->Bind();
-    s_Data->TextureShader->SetMat4("u_ProjectionView", camera->GetProjectionViewMatrix());
+RenderCommandList& Renderer2D::GetCommandList()
+{
+    if (s_Data->Queueing)
+        return *s_Data->QueuedCommands;
 
-    s_Data->FontShader->Bind();
-    s_Data->FontShader->SetMat4("u_ProjectionView", camera->GetProjectionViewMatrix());
+    return s_Data->RecordedCommands ? *s_Data->RecordedCommands : *s_Data->ImmediateCommands;
 }
 
-void Renderer2D::EndScene()
+// Outside of recording and queueing every command is executed as soon as it is submitted
+void Renderer2D::ExecuteImmediate()
+{
+    if (s_Data->Queueing || s_Data->RecordedCommands)
+        return;
+
+    s_Data->Backend->Execute(*s_Data->ImmediateCommands);
+    s_Data->ImmediateCommands->Reset();
+}
+
+void Renderer2D::BeginRecording(const std::shared_ptr<RenderCommandList>& commandList)
+{
+    if (s_Data->RecordedCommands)
+    {
+        LOG_WARN("Renderer2D::BeginRecording: already recording, previous command list is ended");
+        EndRecording();
+    }
+
+    // Quads batched so far were submitted before recording started
+    Flush();
+    s_Data->RecordedCommands = commandList;
+
+    // Recordings of the same frame get the same sort keys, so they can be compared command by command
+    s_Data->SubmissionIndex = 0;
+}
+
+void Renderer2D::EndRecording()
+{
+    Flush();
+    s_Data->RecordedCommands.reset();
+}
+
+void Renderer2D::Execute(const RenderCommandList& commandList)
+{
+    Flush();
+    s_Data->Backend->Execute(commandList);
+}
+
+const std::shared_ptr<RenderBackend>& Renderer2D::GetBackend()
 {
+    return s_Data->Backend;
+}
+
+void Renderer2D::BeginQueue()
+{
+    if (s_Data->Queueing)
+    {
+        LOG_WARN("Renderer2D::BeginQueue: queue has already been begun");
+        return;
+    }
+
+    // Quads batched so far were submitted before the queue
+    Flush();
+
+    s_Data->Queueing = true;
+    s_Data->SubmissionIndex = 0;
+}
+
+void Renderer2D::EndQueue()
+{
+    if (!s_Data->Queueing)
+    {
+        LOG_WARN("Renderer2D::EndQueue: no queue has been begun");
+        return;
+    }
+
+    Flush();
+    s_Data->Queueing = false;
+    s_Data->Layer = RenderLayer::OBJECTS;
+
+    s_Data->QueuedCommands->Sort();
+    if (s_Data->RecordedCommands)
+        s_Data->RecordedCommands->Append(*s_Data->QueuedCommands);
+    else
+        s_Data->Backend->Execute(*s_Data->QueuedCommands);
+
+    s_Data->QueuedCommands->Reset();
+}
+
+void Renderer2D::SetLayer(RenderLayer layer)
+{
+    s_Data->Layer = layer;
+}
+
+void Renderer2D::BeginClip(const glm::vec2& position, const glm::vec2& size)
+{
+    if (s_Data->Queueing)
+        LOG_WARN("Renderer2D::BeginClip: clip begun inside of a queue, it is not applied to the draws submitted after it");
+
+    // Quads batched so far were submitted before the clip and must not be cut by it
+    Flush();
+
+    // Scissor rectangle is given in window pixels
+    const FrameData& frameData = s_Data->FrameUniformData;
+    glm::vec2 bottomLeftPx = (position - size / 2.0f - frameData.ViewportBottomLeft) * frameData.PixelsPerUnit;
+    glm::vec2 sizePx = size * frameData.PixelsPerUnit;
+
+    glm::ivec2 bottomLeft(glm::round(bottomLeftPx));
+    glm::ivec2 extent(glm::round(sizePx));
+
+    GetCommandList().SubmitClipRect({ bottomLeft.x, bottomLeft.y, extent.x, extent.y }, MakeSortKey(s_Data->Layer, 0, 0));
+    ExecuteImmediate();
+}
+
+void Renderer2D::EndClip()
+{
+    if (s_Data->Queueing)
+        LOG_WARN("Renderer2D::EndClip: clip ended inside of a queue");
+
+    // Clipped quads are still batched and have to be drawn before the scissor test is turned off
+    Flush();
+
+    GetCommandList().SubmitResetClipRect(MakeSortKey(s_Data->Layer, 0, 0));
+    ExecuteImmediate();
+}
+
+void Renderer2D::BeginRenderTarget(const std::shared_ptr<FrameBuffer>& frameBuffer, const glm::uvec2& viewportSize)
+{
+    if (s_Data->Queueing)
+        LOG_WARN("Renderer2D::BeginRenderTarget: render target begun inside of a queue, it is not applied to the draws submitted after it");
+
+    if (s_Data->RenderTarget)
+    {
+        LOG_WARN("Renderer2D::BeginRenderTarget: render targets cannot be nested, previous one is ended");
+        EndRenderTarget();
+    }
+
+    // Quads batched so far belong to the previous target
+    Flush();
+
+    s_Data->RenderTarget = frameBuffer;
+    GetCommandList().SubmitBeginRenderTarget(frameBuffer, viewportSize, MakeSortKey(s_Data->Layer, 0, 0));
+    ExecuteImmediate();
+}
+
+void Renderer2D::EndRenderTarget(const std::shared_ptr<Texture2D>& resolveTarget)
+{
+    if (!s_Data->RenderTarget)
+    {
+        LOG_WARN("Renderer2D::EndRenderTarget: no render target has been begun");
+        return;
+    }
+
+    Flush();
+
+    GetCommandList().SubmitEndRenderTarget(s_Data->RenderTarget, resolveTarget, MakeSortKey(s_Data->Layer, 0, 0));
+    s_Data->RenderTarget.reset();
+    ExecuteImmediate();
+}
+
+void Renderer2D::SetBlendMode(BlendMode mode)
+{
+    // Quads batched so far were submitted with the previous blend mode
+    Flush();
+
+    GetCommandList().SubmitBlendMode(mode, MakeSortKey(s_Data->Layer, 0, 0));
+    ExecuteImmediate();
+}
+
+float Renderer2D::GetTextureSlot(const std::shared_ptr<Texture2D>& texture)
+{
+    QuadBatch& batch = GetQuadBatch();
+    for (unsigned int i = 0; i < batch.TextureSlotCount; i++)
+    {
+        if (batch.TextureSlots[i] == texture)
+            return (float)i;
+    }
+
+    if (batch.TextureSlotCount == MAX_TEXTURE_SLOTS)
+        FlushQuadBatch(batch, s_Data->Layer);
+
+    batch.TextureSlots[batch.TextureSlotCount] = texture;
+    return (float)batch.TextureSlotCount++;
+}
+
+void Renderer2D::SubmitQuad(const glm::vec3& position, const glm::vec2& size, const std::shared_ptr<Texture2D>& texture, const glm::vec4& color,
+                            const glm::vec2& texCoordBottomLeft, const glm::vec2& texCoordTopRight)
+{
+    glm::vec2 bottomLeft = texCoordBottomLeft;
+    glm::vec2 topRight = texCoordTopRight;
+
+    // Regions of an atlas take up the slot of the atlas itself, so all sprites of one atlas are drawn in one batch
+    bool isSubTexture = texture && texture->IsSubTexture();
+    if (isSubTexture)
+    {
+        glm::vec2 regionSize = texture->GetTexCoordTopRight() - texture->GetTexCoordBottomLeft();
+        bottomLeft = texture->GetTexCoordBottomLeft() + texCoordBottomLeft * regionSize;
+        topRight = texture->GetTexCoordBottomLeft() + texCoordTopRight * regionSize;
+    }
+
+    const glm::vec2 texCoords[4] = {
+        { bottomLeft.x, bottomLeft.y },
+        { topRight.x,   bottomLeft.y },
+        { topRight.x,   topRight.y   },
+        { bottomLeft.x, topRight.y   }
+    };
+
+    float textureIndex = GetTextureSlot(isSubTexture ? texture->GetAtlas() : texture);
+
+    for (int i = 0; i < 4; i++)
+    {
+        GetQuadBatch().Vertices.push_back({
+            { position.x + s_QuadOutline[i].x * size.x, position.y + s_QuadOutline[i].y * size.y, position.z },
+            color,
+            texCoords[i],
+            textureIndex
+        });
+    }
+
+    s_Data->Stats.QuadCount++;
+}
+
+// Submits an arbitrary convex quadrilateral with flat color, corners given in winding order
+void Renderer2D::SubmitQuad(const glm::vec2 (&corners)[4], float z, const glm::vec4& color)
+{
+    float textureIndex = GetTextureSlot(nullptr);
+
+    for (int i = 0; i < 4; i++)
+        GetQuadBatch().Vertices.push_back({ { corners[i], z }, color, glm::vec2(0.0f), textureIndex });
+
+    s_Data->Stats.QuadCount++;
+}
+
+void Renderer2D::SubmitHexagon(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color)
+{
+    glm::vec2 corners[6];
+    for (int i = 0; i < 6; i++)
+        corners[i] = glm::vec2(position) + s_HexagonOutline[i] * size;
+
+    SubmitQuad({ corners[0], corners[1], corners[2], corners[3] }, position.z, color);
+    SubmitQuad({ corners[3], corners[4], corners[5], corners[0] }, position.z, color);
+}
+
+// Outline is built as a ring of quads between the outline scaled to the full size and to the inner size,
+// so it is batched together with fills instead of being masked out through the stencil buffer
+void Renderer2D::SubmitOutline(const glm::vec2* outline, unsigned int count, const glm::vec3& position, const glm::vec2& size,
+                               const glm::vec4& color, float borderThickness)
+{
+    if (borderThickness < 0.0f || borderThickness > 100.0f)
+    {
+        LOG_WARN("Renderer2D::SubmitOutline: borderThickness parameter outside of 0-100 bound");
+        borderThickness = Util::Clamp<float>(borderThickness, 0.0f, 100.0f);
+    }
+
+    float ratio = (100.0f - borderThickness) / 100.0f;
+    float innerHeight = ratio * size.y;
+    float innerWidth = size.x - (size.y - innerHeight);
+    glm::vec2 innerSize = { innerWidth, innerHeight };
+
+    for (unsigned int i = 0; i < count; i++)
+    {
+        unsigned int next = (i + 1) % count;
+        SubmitQuad({
+            glm::vec2(position) + outline[i] * size,
+            glm::vec2(position) + outline[next] * size,
+            glm::vec2(position) + outline[next] * innerSize,
+            glm::vec2(position) + outline[i] * innerSize
+        }, position.z, color);
+    }
 }
 
 void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color, std::optional<float> borderThickness)
@@ -112,7 +402,10 @@ void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, cons
 
 void Renderer2D::DrawQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color, std::optional<float> borderThickness)
 {
-    DrawGeometry(s_Data->QuadVertexArray, position, size, color, borderThickness);
+    if (borderThickness.has_value())
+        SubmitOutline(s_QuadOutline, 4, position, size, color, borderThickness.value());
+    else
+        SubmitQuad(position, size, nullptr, color);
 }
 
 void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, const std::shared_ptr<Texture2D>& texture, const glm::vec4& color)
@@ -122,16 +415,7 @@ void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, cons
 
 void Renderer2D::DrawQuad(const glm::vec3& position, const glm::vec2& size, const std::shared_ptr<Texture2D>& texture, const glm::vec4& color)
 {
-    glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(position)) * glm::scale(glm::mat4(1.0f), glm::vec3(size.x, size.y, 1.0f));
-
-    texture->Bind(0);
-    s_Data->TextureShader->Bind();
-    s_Data->TextureShader->SetInt("u_Texture", 0);
-    s_Data->TextureShader->SetMat4("u_Model", model);
-    s_Data->TextureShader->SetFloat4("u_Color", color);
-
-    s_Data->QuadVertexArray->Bind();
-    glDrawElements(GL_TRIANGLES, s_Data->QuadVertexArray->GetIndexBuffer()->GetIndexCount(), GL_UNSIGNED_INT, nullptr);
+    SubmitQuad(position, size, texture, color);
 }
 
 void Renderer2D::DrawHexagon(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color, std::optional<float> borderThickness)
@@ -141,73 +425,53 @@ void Renderer2D::DrawHexagon(const glm::vec2& position, const glm::vec2& size, c
 
 void Renderer2D::DrawHexagon(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color, std::optional<float> borderThickness)
 {
-    DrawGeometry(s_Data->HexagonVertexArray, position, size, color, borderThickness);
+    if (borderThickness.has_value())
+        SubmitOutline(s_HexagonOutline, 6, position, size, color, borderThickness.value());
+    else
+        SubmitHexagon(position, size, color);
 }
 
-void Renderer2D::DrawHexagon(const glm::vec2& position, const glm::vec2& size, const std::shared_ptr<Shader>& shader, ShaderData& shaderData)
+void Renderer2D::DrawHexagon(const glm::vec2& position, const glm::vec2& size, const std::shared_ptr<Shader>& shader, const ShaderParams& params)
 {
-    DrawHexagon(glm::vec3(position, 0.0f), size, shader, shaderData);
+    DrawHexagon(glm::vec3(position, 0.0f), size, shader, params);
 }
 
-void Renderer2D::DrawHexagon(const glm::vec3& position, const glm::vec2& size, const std::shared_ptr<Shader>& shader, ShaderData& shaderData)
+void Renderer2D::DrawHexagon(const glm::vec3& position, const glm::vec2& size, const std::shared_ptr<Shader>& shader, const ShaderParams& params)
 {
+    FlushUnlessQueued();
+
     glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(position)) * glm::scale(glm::mat4(1.0f), glm::vec3(size.x, size.y, 1.0f));
-    s_Data->HexagonVertexArray->Bind();
+    GetCommandList().SubmitHexagon(shader, model, params, MakeSortKey(s_Data->Layer, shader->GetHandle(), 0));
+    s_Data->Stats.DrawCalls++;
 
-    shader->Bind();
-    shader->SetMat4("u_ProjectionView", s_Data->Camera->GetProjectionViewMatrix());
-    shader->SetMat4("u_Model", model);
-    shaderData.Apply(shader);
+    ExecuteImmediate();
+}
+
+void Renderer2D::DrawHexagonInstances(const std::shared_ptr<HexagonInstances>& instances, const std::shared_ptr<Shader>& shader,
+                                      const std::shared_ptr<Texture2D>& texture)
+{
+    if (instances->GetCount() == 0)
+        return;
 
-    glDrawElements(GL_TRIANGLES, s_Data->HexagonVertexArray->GetIndexBuffer()->GetIndexCount(), GL_UNSIGNED_INT, nullptr);
+    FlushUnlessQueued();
+
+    uint64_t sortKey = MakeSortKey(s_Data->Layer, shader ? shader->GetHandle() : 0, texture ? texture->GetHandle() : 0);
+    GetCommandList().SubmitHexagonInstances(instances, shader, texture, sortKey);
+    s_Data->Stats.DrawCalls++;
+    s_Data->Stats.HexagonInstanceCount += instances->GetCount();
+
+    ExecuteImmediate();
 }
 
-void Renderer2D::DrawGeometry(const std::shared_ptr<VertexArray>& vertexArray, const glm::vec3& position, const glm::vec2& size, const glm::vec4& color, std::optional<float> borderThickness)
+void Renderer2D::DrawGeometry(const std::shared_ptr<VertexArray>& vertexArray, const glm::vec3& position, const glm::vec2& size, const glm::vec4& color)
 {
-    glm::mat4 fullScaleModel = glm::translate(glm::mat4(1.0f), glm::vec3(position)) * glm::scale(glm::mat4(1.0f), glm::vec3(size.x, size.y, 1.0f));
-    vertexArray->Bind();
-    s_Data->FlatColorShader->Bind();
+    FlushUnlessQueued();
 
-    if (!borderThickness.has_value())
-    {
-        s_Data->FlatColorShader->SetMat4("u_Model", fullScaleModel);
-        s_Data->FlatColorShader->SetFloat4("u_Color", color);
-        glDrawElements(GL_TRIANGLES, vertexArray->GetIndexBuffer()->GetIndexCount(), GL_UNSIGNED_INT, nullptr);
-    }
-    else
-    {
-        float thickness = borderThickness.value();
-        if (thickness < 0.0f || thickness > 100.0f)
-        {
-            LOG_WARN("Renderer2D::DrawGeometry: borderThickness parameter outside of 0-100 bound");
-            thickness = Util::Clamp<float>(thickness, 0.0f, 100.0f);
-        }
-
-        float ratio = (100.0f - thickness) / 100.0f;
-        float outerHeight = size.y;
-        float innerHeight = ratio * size.y;
-        float heightDiff = outerHeight - innerHeight;
-        float innerWidth = size.x - heightDiff;
-
-        glClear(GL_STENCIL_BUFFER_BIT);
-        glStencilFunc(GL_ALWAYS, 1, 0xFF);
-        glStencilMask(0xFF);
-
-        glm::mat4 scaledDownModel = glm::translate(glm::mat4(1.0f), glm::vec3(position)) * glm::scale(glm::mat4(1.0f), glm::vec3(innerWidth, innerHeight, 1.0f));
-        s_Data->FlatColorShader->SetMat4("u_Model", scaledDownModel);
-        s_Data->FlatColorShader->SetFloat4("u_Color", glm::vec4(0.0f));
-        glDrawElements(GL_TRIANGLES, vertexArray->GetIndexBuffer()->GetIndexCount(), GL_UNSIGNED_INT, nullptr);
-
-        glStencilFunc(GL_NOTEQUAL, 1, 0xFF);
-        glStencilMask(0x00);
-
-        s_Data->FlatColorShader->SetMat4("u_Model", fullScaleModel);
-        s_Data->FlatColorShader->SetFloat4("u_Color", color);
-        glDrawElements(GL_TRIANGLES, vertexArray->GetIndexBuffer()->GetIndexCount(), GL_UNSIGNED_INT, nullptr);
-
-        glStencilFunc(GL_ALWAYS, 1, 0xFF);
-        glStencilMask(0xFF);
-    }
+    glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(position)) * glm::scale(glm::mat4(1.0f), glm::vec3(size.x, size.y, 1.0f));
+    GetCommandList().SubmitGeometry(vertexArray, model, color, MakeSortKey(s_Data->Layer, 0, 0));
+    s_Data->Stats.DrawCalls++;
+
+    ExecuteImmediate();
 }
 
 void Renderer2D::DrawTextStr(const std::string& text, const glm::vec2& position, float scale, const glm::vec3& color,
@@ -219,114 +483,84 @@ void Renderer2D::DrawTextStr(const std::string& text, const glm::vec2& position,
 void Renderer2D::DrawTextStr(const std::string& text, const glm::vec2& position, float scale, const glm::vec4& color,
                              HTextAlign hAlign, VTextAlign vAlign, const std::string& fontName)
 {
-    glm::vec2 pos_cpy = { position.x, position.y };
-
-    s_Data->FontShader->Bind();
-
-    auto font = ResourceManager::GetFont(fontName);
-    auto characters = font->GetCharacters();
+    const auto& font = ResourceManager::GetFont(fontName);
+    if (!font->GetAtlas() || text.empty())
+        return;
 
-    std::vector<std::string> lines;
-    std::istringstream iss(text);
-    std::string line;
+    const TextLayout& layout = s_Data->TextLayouts.Get(text, font);
+    glm::vec2 relPixelSize = s_Data->Camera->ConvertPixelSizeToRelative(glm::vec2(1.0f)) * scale;
 
-    while (std::getline(iss, line, '\n'))
-        lines.push_back(line);
-
-    float relCharHeight = s_Data->Camera->ConvertPixelSizeToRelative(characters['A'].Size.y) * scale;
-    float relSpacing = relCharHeight * FONT_Y_SPACING_RATIO;
+    // Alignment offsets in pixels of the font, the layout starts at the baseline of the first line
+    float lineCount = layout.LineCount;
+    float spacing = layout.LineHeight * FONT_Y_SPACING_RATIO;
+    glm::vec2 offset = glm::vec2(0.0f);
 
     switch (vAlign)
     {
         case VTextAlign::BOTTOM:
-            pos_cpy.y += (relCharHeight + relSpacing) * (lines.size() - 1);
+            offset.y = (layout.LineHeight + spacing) * (lineCount - 1.0f);
             break;
         case VTextAlign::MIDDLE:
-            pos_cpy.y += ((relCharHeight / 2.0f) * (lines.size() - 2.0f)) + (relSpacing * ((lines.size() - 1.0f) / 2.0f));
+            offset.y = ((layout.LineHeight / 2.0f) * (lineCount - 2.0f)) + (spacing * ((lineCount - 1.0f) / 2.0f));
             break;
         case VTextAlign::TOP:
-            pos_cpy.y -= relCharHeight;
+            offset.y = -layout.LineHeight;
+            break;
+    }
+
+    float lineWidthRatio = 0.0f;
+    switch (hAlign)
+    {
+        case HTextAlign::LEFT:
+            break;
+        case HTextAlign::MIDDLE:
+            lineWidthRatio = 0.5f;
+            break;
+        case HTextAlign::RIGHT:
+            lineWidthRatio = 1.0f;
             break;
     }
 
-    for (const auto& line : lines)
+    for (const auto& glyph : layout.Glyphs)
     {
-        // Determine horizontal length of a line
-        float lineLength = 0.0f;
-        for (std::string::const_iterator it = line.begin(); it != line.end(); it++)
-        {
-            auto c = characters[*it];
-            lineLength += s_Data->Camera->ConvertPixelSizeToRelative(c.Advance >> 6) * scale;
-        }
-
-        switch (hAlign)
-        {
-            case HTextAlign::LEFT:
-                break;
-            case HTextAlign::MIDDLE:
-                pos_cpy.x -= lineLength / 2;
-                break;
-            case HTextAlign::RIGHT:
-                pos_cpy.x -= lineLength;
-                break;
-        }
-
-        for (std::string::const_iterator c = line.begin(); c != line.end(); c++)
-        {
-            Font::Character ch = characters[*c];
-
-            if (*c == ' ')
-            {
-                pos_cpy.x += s_Data->Camera->ConvertPixelSizeToRelative(ch.Advance >> 6) * scale;
-            }
-            else
-            {
-                float xpos = pos_cpy.x + s_Data->Camera->ConvertPixelSizeToRelative(ch.Bearing.x) * scale;
-                float ypos = pos_cpy.y - s_Data->Camera->ConvertPixelSizeToRelative(ch.Size.y - ch.Bearing.y) * scale;
-                glm::vec2 chRelSize = s_Data->Camera->ConvertPixelSizeToRelative(glm::vec2(ch.Size)) * scale;
-                glm::mat4 chModel = glm::translate(glm::mat4(1.0f), glm::vec3(xpos, ypos, 0.0f)) *
-                                    glm::scale(glm::mat4(1.0f), glm::vec3(chRelSize.x, chRelSize.y, 1.0f));
-
-                ch.Texture->Bind(0);
-                s_Data->FontShader->SetInt("u_Texture", 0);
-                s_Data->FontShader->SetMat4("u_Model", chModel);
-                s_Data->FontShader->SetFloat4("u_Color", color);
-
-                s_Data->FontVertexArray->Bind();
-                s_Data->FontVertexArray->GetIndexBuffer()->Bind();
-                glDrawElements(GL_TRIANGLES, s_Data->FontVertexArray->GetIndexBuffer()->GetIndexCount(), GL_UNSIGNED_INT, nullptr);
-
-                pos_cpy.x += s_Data->Camera->ConvertPixelSizeToRelative(ch.Advance >> 6) * scale;
-            }
-        }
-
-        pos_cpy.x = position.x;
-        pos_cpy.y -= relCharHeight + relSpacing;
+        glm::vec2 glyphPosition = {
+            position.x + (glyph.Position.x - glyph.LineWidth * lineWidthRatio) * relPixelSize.x,
+            position.y + (glyph.Position.y + offset.y) * relPixelSize.x
+        };
+        glm::vec2 glyphRelSize = glyph.Size * relPixelSize;
+
+        SubmitQuad(
+            { glyphPosition + glyphRelSize / 2.0f, 0.0f },
+            glyphRelSize,
+            font->GetAtlas(),
+            color,
+            glyph.TexCoordBottomLeft,
+            glyph.TexCoordTopRight
+        );
     }
 }
 
 glm::vec2 Renderer2D::GetTextSize(const std::shared_ptr<OrthographicCamera>& camera, const std::string& text,
                                   const std::string& fontName)
 {
-    auto characters = ResourceManager::GetFont(fontName)->GetCharacters();
-
-    float maxCharHeightPx = 0.0f;
-    float textWidth = 0.0f;
+    const TextLayout& layout = s_Data->TextLayouts.Get(text, ResourceManager::GetFont(fontName));
+    return { camera->ConvertPixelSizeToRelative(layout.AdvanceSum), camera->ConvertPixelSizeToRelative(layout.MaxGlyphHeight, false) };
+}
 
-    for (std::string::const_iterator c = text.begin(); c != text.end(); c++)
-    {
-        float charHeightPx = characters[*c].Size.y;
-        if (charHeightPx > maxCharHeightPx)
-            maxCharHeightPx = charHeightPx;
+void Renderer2D::ClearColor(const glm::vec4& color)
+{
+    Flush();
 
-        textWidth += camera->ConvertPixelSizeToRelative(characters[*c].Advance >> 6);
-    }
+    GetCommandList().SubmitClear(color, MakeSortKey(s_Data->Layer, 0, 0));
+    ExecuteImmediate();
+}
 
-    return { textWidth, camera->ConvertPixelSizeToRelative(maxCharHeightPx, false) };
+const Renderer2D::Statistics& Renderer2D::GetStats()
+{
+    return s_Data->Stats;
 }
 
-void Renderer2D::ClearColor(const glm::vec4& color)
+void Renderer2D::ResetStats()
 {
-    glClearColor(color.r, color.g, color.b, color.a);
-    glClear(GL_COLOR_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+    s_Data->Stats = Statistics();
 }
@@ -1,18 +1,28 @@
 #pragma once
 
+#include <array>
 #include <memory>
+#include <vector>
 #include <optional>
 
 #include <glm/glm.hpp>
 
 #include "core/camera.h"
 #include "graphics/shader.h"
+#include "graphics/buffer.h"
 #include "graphics/texture.h"
 #include "graphics/vertex_array.h"
+#include "graphics/render_backend.h"
+#include "graphics/render_command.h"
+#include "graphics/hexagon_instances.h"
+#include "graphics/text_layout_cache.h"
 
 // ratio of character spacing to character height
 #define FONT_Y_SPACING_RATIO 0.3f
 
+// number of values in RenderLayer
+#define RENDER_LAYER_COUNT 6
+
 enum class HTextAlign
 {
     LEFT   = 0,
@@ -27,14 +37,54 @@ enum class VTextAlign
     BOTTOM = 2
 };
 
+// Queued draws of a lower layer always end up below the ones of a higher layer,
+// within a layer they are grouped by shader and can be drawn in a different order
+enum class RenderLayer : uint8_t
+{
+    BACKGROUND  = 0,
+    TERRAIN     = 1,
+    ENVIRONMENT = 2,
+    OBJECTS     = 3,
+    EFFECTS     = 4,
+    OVERLAY     = 5
+};
+
 class Renderer2D
 {
 public:
-    static void Init();
+    // Draws through OpenGL unless another backend is given, e.g. NullRenderBackend when there is no context
+    static void Init(const std::shared_ptr<RenderBackend>& backend = nullptr);
     static void Shutdown();
 
+    // Seconds passed to the shaders through FrameData, set once per frame by the application
+    static void SetTime(float time);
+
     static void BeginScene(const std::shared_ptr<OrthographicCamera>& camera);
     static void EndScene();
+    static void Flush();
+
+    // Commands submitted between these calls are appended to the list instead of being executed
+    static void BeginRecording(const std::shared_ptr<RenderCommandList>& commandList);
+    static void EndRecording();
+    static void Execute(const RenderCommandList& commandList);
+    static const std::shared_ptr<RenderBackend>& GetBackend();
+
+    // Draws submitted between these calls are sorted by layer and shader before they are executed,
+    // quads of each layer are batched together regardless of other draws submitted in between.
+    // Scene changes and clipping are not kept in order, they belong outside of a queue.
+    static void BeginQueue();
+    static void EndQueue();
+    static void SetLayer(RenderLayer layer);
+
+    // Restricts drawing to a rectangle given in coordinates of the current scene camera
+    static void BeginClip(const glm::vec2& position, const glm::vec2& size);
+    static void EndClip();
+
+    // Draws between these calls go into the framebuffer, only into its bottom left corner when a viewport size is given.
+    // It is resolved into the given texture, or into its own one without it. Like clipping, render targets belong outside of a queue.
+    static void BeginRenderTarget(const std::shared_ptr<FrameBuffer>& frameBuffer, const glm::uvec2& viewportSize = glm::uvec2(0));
+    static void EndRenderTarget(const std::shared_ptr<Texture2D>& resolveTarget = nullptr);
+    static void SetBlendMode(BlendMode mode);
 
     static void DrawQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color,
                          std::optional<float> borderThickness = std::nullopt);
@@ -51,12 +101,15 @@ public:
     static void DrawHexagon(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color,
                             std::optional<float> borderThickness = std::nullopt);
     static void DrawHexagon(const glm::vec2& position, const glm::vec2& size, const std::shared_ptr<Shader>& shader,
-                            ShaderData& shaderData);
+                            const ShaderParams& params);
     static void DrawHexagon(const glm::vec3& position, const glm::vec2& size, const std::shared_ptr<Shader>& shader,
-                            ShaderData& shaderData);
+                            const ShaderParams& params);
+
+    static void DrawHexagonInstances(const std::shared_ptr<HexagonInstances>& instances, const std::shared_ptr<Shader>& shader = nullptr,
+                                     const std::shared_ptr<Texture2D>& texture = nullptr);
 
     static void DrawGeometry(const std::shared_ptr<VertexArray>& vertexArray, const glm::vec3& position, const glm::vec2& size,
-                             const glm::vec4& color, std::optional<float> borderThickness = std::nullopt);
+                             const glm::vec4& color);
 
     static void DrawTextStr(const std::string& text, const glm::vec2& position, float scale, const glm::vec3& color = glm::vec3(1.0f),
                             HTextAlign hAlign = HTextAlign::LEFT, VTextAlign vAlign = VTextAlign::BOTTOM,
@@ -70,16 +123,69 @@ public:
 
     static void ClearColor(const glm::vec4& color);
 
+    struct Statistics
+    {
+        unsigned int DrawCalls = 0;
+        unsigned int QuadCount = 0;
+        unsigned int HexagonInstanceCount = 0;
+    };
+
+    static const Statistics& GetStats();
+    static void ResetStats();
+
+    // corners of the unit shapes in winding order
+    static const glm::vec2 s_QuadOutline[4];
+    static const glm::vec2 s_HexagonOutline[6];
+
+private:
+    struct QuadBatch
+    {
+        std::vector<QuadVertex> Vertices;
+        // untextured quads occupy a slot holding no texture
+        std::array<std::shared_ptr<Texture2D>, MAX_TEXTURE_SLOTS> TextureSlots;
+        unsigned int TextureSlotCount = 0;
+    };
+
+    static RenderCommandList& GetCommandList();
+    static void ExecuteImmediate();
+    static void FlushQuadBatch(QuadBatch& batch, RenderLayer layer);
+    static void FlushUnlessQueued();
+    static QuadBatch& GetQuadBatch();
+    static uint64_t MakeSortKey(RenderLayer layer, unsigned int shaderHandle, unsigned int textureHandle);
+
+    static void SubmitQuad(const glm::vec3& position, const glm::vec2& size, const std::shared_ptr<Texture2D>& texture,
+                           const glm::vec4& color, const glm::vec2& texCoordBottomLeft = glm::vec2(0.0f),
+                           const glm::vec2& texCoordTopRight = glm::vec2(1.0f));
+    static void SubmitQuad(const glm::vec2 (&corners)[4], float z, const glm::vec4& color);
+    static void SubmitHexagon(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color);
+    static void SubmitOutline(const glm::vec2* outline, unsigned int count, const glm::vec3& position, const glm::vec2& size,
+                              const glm::vec4& color, float borderThickness);
+    static float GetTextureSlot(const std::shared_ptr<Texture2D>& texture);
+
 private:
     struct Renderer2DData
     {
         std::shared_ptr<OrthographicCamera> Camera;
-        std::shared_ptr<VertexArray> QuadVertexArray;
-        std::shared_ptr<VertexArray> FontVertexArray;
-        std::shared_ptr<VertexArray> HexagonVertexArray;
-        std::shared_ptr<Shader> FlatColorShader;
-        std::shared_ptr<Shader> TextureShader;
-        std::shared_ptr<Shader> FontShader;
+
+        std::shared_ptr<RenderBackend> Backend;
+        std::shared_ptr<RenderCommandList> ImmediateCommands;
+        std::shared_ptr<RenderCommandList> RecordedCommands;
+        std::shared_ptr<RenderCommandList> QueuedCommands;
+        bool Queueing = false;
+
+        std::shared_ptr<FrameBuffer> RenderTarget;
+
+        // without a queue every quad goes to the first batch
+        std::array<QuadBatch, RENDER_LAYER_COUNT> QuadBatches;
+        RenderLayer Layer = RenderLayer::OBJECTS;
+        unsigned int SubmissionIndex = 0;
+
+        FrameData FrameUniformData;
+        float Time = 0.0f;
+
+        TextLayoutCache TextLayouts;
+
+        Statistics Stats;
     };
 
     static Renderer2DData* s_Data;
@@ -7,39 +7,56 @@
 #include <glm/gtc/type_ptr.hpp>
 
 #include "core/logger.h"
+#include "graphics/render_state.h"
+#include "graphics/graphics_context.h"
 #include "core/file_system.h"
 #include "util/util.h"
 
+unsigned int Shader::s_NextHandle = 1;
+
 Shader::Shader(const std::string& filepath)
-    : m_FilePath(filepath)
+    : m_FilePath(filepath), m_ProgramID(0), m_Handle(s_NextHandle++)
 {
     m_Name = Util::ExtractFileNameFromPath(filepath);
 
+    // Without a context every uniform resolves to -1
+    if (!GraphicsContext::IsAvailable())
+        return;
+
     std::string source = FileSystem::ReadFile(filepath);
     ShaderSourceMap shaderSources = Parse(source);
     m_ProgramID = Compile(shaderSources);
+    ReflectUniforms();
 }
 
 Shader::~Shader()
 {
+    if (!GraphicsContext::IsAvailable())
+        return;
+
     glDeleteProgram(m_ProgramID);
+    RenderState::OnProgramDeleted(m_ProgramID);
 }
 
 void Shader::Bind() const
 {
-    glUseProgram(m_ProgramID);
+    RenderState::UseProgram(m_ProgramID);
 }
 
 void Shader::Unbind() const
 {
-    glUseProgram(0);
+    RenderState::UseProgram(0);
 }
 
 void Shader::Reload(const std::string& filepath)
 {
+    if (!GraphicsContext::IsAvailable())
+        return;
+
     std::string source = FileSystem::ReadFile(filepath.empty() ? m_FilePath : filepath);
     ShaderSourceMap shaderSources = Parse(source);
     m_ProgramID = Compile(shaderSources);
+    ReflectUniforms();
 }
 
 std::string Shader::ShaderTypeToStr(unsigned int type)
@@ -154,70 +171,154 @@ unsigned int Shader::Compile(const ShaderSourceMap& shaderSources)
     return program;
 }
 
+void Shader::ReflectUniforms()
+{
+    m_UniformLocations.clear();
+
+    int uniformCount = 0;
+    glGetProgramiv(m_ProgramID, GL_ACTIVE_UNIFORMS, &uniformCount);
+
+    int maxNameLength = 0;
+    glGetProgramiv(m_ProgramID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+    std::vector<char> nameBuffer(maxNameLength + 1);
+
+    for (int i = 0; i < uniformCount; i++)
+    {
+        int length, size;
+        unsigned int type;
+        glGetActiveUniform(m_ProgramID, i, nameBuffer.size(), &length, &size, &type, nameBuffer.data());
+
+        std::string name(nameBuffer.data(), length);
+        int location = glGetUniformLocation(m_ProgramID, name.c_str());
+
+        // Arrays are reported as "name[0]", they are set through their base name
+        size_t bracket = name.find('[');
+        if (bracket != std::string::npos)
+            name = name.substr(0, bracket);
+
+        m_UniformLocations[name] = location;
+    }
+
+    for (int i = 0; i < m_UniformSlotNames.size(); i++)
+        m_UniformSlotLocations[i] = GetUniformLocation(m_UniformSlotNames[i]);
+
+    m_ParamLocations.Model = GetUniformLocation("u_Model");
+    m_ParamLocations.Color = GetUniformLocation("u_Color");
+    m_ParamLocations.EffectPosition = GetUniformLocation("u_EffectPosition");
+    m_ParamLocations.EffectSize = GetUniformLocation("u_EffectSize");
+    m_ParamLocations.Animated = GetUniformLocation("u_Animated");
+
+    unsigned int frameDataIndex = glGetUniformBlockIndex(m_ProgramID, "FrameData");
+    if (frameDataIndex != GL_INVALID_INDEX)
+        glUniformBlockBinding(m_ProgramID, frameDataIndex, FRAME_DATA_BINDING);
+}
+
+int Shader::RegisterUniform(const std::string& name)
+{
+    for (int i = 0; i < m_UniformSlotNames.size(); i++)
+    {
+        if (m_UniformSlotNames[i] == name)
+            return i;
+    }
+
+    if (m_UniformLocations.find(name) == m_UniformLocations.end())
+        LOG_WARN("Shader: name '{0}' has no active uniform '{1}'", m_Name, name);
+
+    m_UniformSlotNames.push_back(name);
+    m_UniformSlotLocations.push_back(GetUniformLocation(name));
+    return m_UniformSlotNames.size() - 1;
+}
+
+int Shader::GetUniformLocation(const std::string& name) const
+{
+    auto it = m_UniformLocations.find(name);
+    return it != m_UniformLocations.end() ? it->second : -1;
+}
+
 void Shader::SetBool(const std::string& name, bool value)
 {
-    int location = glGetUniformLocation(m_ProgramID, name.c_str());
-    glUniform1i(location, value);
+    glUniform1i(GetUniformLocation(name), value);
 }
 
 void Shader::SetInt(const std::string& name, int value)
 {
-    int location = glGetUniformLocation(m_ProgramID, name.c_str());
-    glUniform1i(location, value);
+    glUniform1i(GetUniformLocation(name), value);
+}
+
+void Shader::SetIntArray(const std::string& name, int* values, unsigned int count)
+{
+    glUniform1iv(GetUniformLocation(name), count, values);
 }
 
 void Shader::SetFloat(const std::string& name, float value)
 {
-    int location = glGetUniformLocation(m_ProgramID, name.c_str());
-    glUniform1f(location, value);
+    glUniform1f(GetUniformLocation(name), value);
 }
 
 void Shader::SetFloat2(const std::string& name, const glm::vec2& value)
 {
-    int location = glGetUniformLocation(m_ProgramID, name.c_str());
-    glUniform2f(location, value.x, value.y);
+    glUniform2f(GetUniformLocation(name), value.x, value.y);
 }
 
 void Shader::SetFloat3(const std::string& name, const glm::vec3& value)
 {
-    int location = glGetUniformLocation(m_ProgramID, name.c_str());
-    glUniform3f(location, value.x, value.y, value.z);
+    glUniform3f(GetUniformLocation(name), value.x, value.y, value.z);
 }
 
 void Shader::SetFloat4(const std::string& name, const glm::vec4& value)
 {
-    int location = glGetUniformLocation(m_ProgramID, name.c_str());
-    glUniform4f(location, value.x, value.y, value.z, value.w);
+    glUniform4f(GetUniformLocation(name), value.x, value.y, value.z, value.w);
 }
 
 void Shader::SetMat4(const std::string& name, const glm::mat4& value)
 {
-    int location = glGetUniformLocation(m_ProgramID, name.c_str());
-    glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+    glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, glm::value_ptr(value));
 }
 
-void ShaderData::Apply(const std::shared_ptr<Shader>& shader)
+void Shader::Set(Uniform<bool> uniform, bool value)
 {
-    for (const auto& pair : UniformMap)
-    {
-        const std::string& key = pair.first;
-        const UniformValue& value = pair.second;
-
-        if (std::holds_alternative<bool>(value))
-            shader->SetBool(key, std::get<bool>(value));
-        else if (std::holds_alternative<int>(value))
-            shader->SetInt(key, std::get<int>(value));
-        else if (std::holds_alternative<float>(value))
-            shader->SetFloat(key, std::get<float>(value));
-        else if (std::holds_alternative<glm::vec2>(value))
-            shader->SetFloat2(key, std::get<glm::vec2>(value));
-        else if (std::holds_alternative<glm::vec3>(value))
-            shader->SetFloat3(key, std::get<glm::vec3>(value));
-        else if (std::holds_alternative<glm::vec4>(value))
-            shader->SetFloat4(key, std::get<glm::vec4>(value));
-        else if (std::holds_alternative<glm::mat4>(value))
-            shader->SetMat4(key, std::get<glm::mat4>(value));
-        else
-            LOG_WARN("Cannot apply uniform to shader - unknown type");
-    }
+    glUniform1i(GetUniformLocation(uniform.Index), value);
+}
+
+void Shader::Set(Uniform<int> uniform, int value)
+{
+    glUniform1i(GetUniformLocation(uniform.Index), value);
+}
+
+void Shader::Set(Uniform<float> uniform, float value)
+{
+    glUniform1f(GetUniformLocation(uniform.Index), value);
+}
+
+void Shader::Set(Uniform<glm::vec2> uniform, const glm::vec2& value)
+{
+    glUniform2f(GetUniformLocation(uniform.Index), value.x, value.y);
+}
+
+void Shader::Set(Uniform<glm::vec3> uniform, const glm::vec3& value)
+{
+    glUniform3f(GetUniformLocation(uniform.Index), value.x, value.y, value.z);
+}
+
+void Shader::Set(Uniform<glm::vec4> uniform, const glm::vec4& value)
+{
+    glUniform4f(GetUniformLocation(uniform.Index), value.x, value.y, value.z, value.w);
+}
+
+void Shader::Set(Uniform<glm::mat4> uniform, const glm::mat4& value)
+{
+    glUniformMatrix4fv(GetUniformLocation(uniform.Index), 1, GL_FALSE, glm::value_ptr(value));
+}
+
+void Shader::SetModel(const glm::mat4& model)
+{
+    glUniformMatrix4fv(m_ParamLocations.Model, 1, GL_FALSE, glm::value_ptr(model));
+}
+
+void Shader::SetParams(const ShaderParams& params)
+{
+    glUniform4f(m_ParamLocations.Color, params.Color.r, params.Color.g, params.Color.b, params.Color.a);
+    glUniform2f(m_ParamLocations.EffectPosition, params.EffectPosition.x, params.EffectPosition.y);
+    glUniform2f(m_ParamLocations.EffectSize, params.EffectSize.x, params.EffectSize.y);
+    glUniform1i(m_ParamLocations.Animated, params.Animated);
 }
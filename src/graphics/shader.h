@@ -2,11 +2,32 @@
 
 #include <memory>
 #include <string>
-#include <variant>
+#include <vector>
 #include <unordered_map>
 
 #include <glm/glm.hpp>
 
+// binding point of the FrameData uniform block, shared by every shader
+#define FRAME_DATA_BINDING 0
+
+// Handle to a uniform resolved once through Shader::GetUniform.
+// It stays valid when the shader is reloaded, since it refers to a slot rather than a GL location.
+template<typename T>
+struct Uniform
+{
+    int Index = -1;
+};
+
+// Fixed set of per-draw parameters understood by the effect shaders (water, hue, potion).
+// Effect position and size describe the area in relative units the effect is laid out in.
+struct ShaderParams
+{
+    glm::vec4 Color = glm::vec4(1.0f);
+    glm::vec2 EffectPosition = glm::vec2(0.0f);
+    glm::vec2 EffectSize = glm::vec2(0.0f);
+    bool Animated = true;
+};
+
 class Shader
 {
     using ShaderSourceMap = std::unordered_map<unsigned int, std::string>;
@@ -19,28 +40,63 @@ public:
 
     void Reload(const std::string& filepath = "");
 
+    inline unsigned int GetID() const { return m_ProgramID; }
+    // Process-wide number of the shader, unlike the program name it is also given out without a context and survives reloads
+    inline unsigned int GetHandle() const { return m_Handle; }
+
     void SetBool(const std::string& name, bool value);
     void SetInt(const std::string& name, int value);
+    void SetIntArray(const std::string& name, int* values, unsigned int count);
     void SetFloat(const std::string& name, float value);
     void SetFloat2(const std::string& name, const glm::vec2& value);
     void SetFloat3(const std::string& name, const glm::vec3& value);
     void SetFloat4(const std::string& name, const glm::vec4& value);
     void SetMat4(const std::string& name, const glm::mat4& value);
 
+    void SetModel(const glm::mat4& model);
+    void SetParams(const ShaderParams& params);
+
+    template<typename T>
+    Uniform<T> GetUniform(const std::string& name) { return { RegisterUniform(name) }; }
+
+    void Set(Uniform<bool> uniform, bool value);
+    void Set(Uniform<int> uniform, int value);
+    void Set(Uniform<float> uniform, float value);
+    void Set(Uniform<glm::vec2> uniform, const glm::vec2& value);
+    void Set(Uniform<glm::vec3> uniform, const glm::vec3& value);
+    void Set(Uniform<glm::vec4> uniform, const glm::vec4& value);
+    void Set(Uniform<glm::mat4> uniform, const glm::mat4& value);
+
 private:
     std::string ShaderTypeToStr(unsigned int type);
     ShaderSourceMap Parse(const std::string& source);
     unsigned int Compile(const ShaderSourceMap& shaderSources);
+    void ReflectUniforms();
+    int RegisterUniform(const std::string& name);
+    int GetUniformLocation(const std::string& name) const;
+    inline int GetUniformLocation(int index) const { return index >= 0 ? m_UniformSlotLocations[index] : -1; }
 
 private:
     std::string m_Name;
     std::string m_FilePath;
     unsigned int m_ProgramID;
-};
+    unsigned int m_Handle;
 
-using UniformValue = std::variant<bool, int, float, glm::vec2, glm::vec3, glm::vec4, glm::mat4>;
-struct ShaderData
-{
-    std::unordered_map<std::string, UniformValue> UniformMap;
-    void Apply(const std::shared_ptr<Shader>& shader);
+    // locations of all active uniforms, queried once after linking
+    std::unordered_map<std::string, int> m_UniformLocations;
+    // uniforms handed out as handles, resolved again whenever the program is relinked
+    std::vector<std::string> m_UniformSlotNames;
+    std::vector<int> m_UniformSlotLocations;
+
+    // locations of the ShaderParams fields, -1 for the ones a shader does not use
+    struct
+    {
+        int Model = -1;
+        int Color = -1;
+        int EffectPosition = -1;
+        int EffectSize = -1;
+        int Animated = -1;
+    } m_ParamLocations;
+
+    static unsigned int s_NextHandle;
 };
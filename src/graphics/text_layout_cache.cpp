@@ -0,0 +1,119 @@
+#include "text_layout_cache.h"
+
+#include <iterator>
+#include <algorithm>
+#include <functional>
+
+#include "graphics/renderer.h"
+
+TextLayoutCache::TextLayoutCache(unsigned int capacity)
+    : m_Capacity(glm::max(capacity, 1u))
+{
+    m_Lookup.reserve(m_Capacity);
+}
+
+const TextLayout& TextLayoutCache::Get(const std::string& text, const std::shared_ptr<Font>& font)
+{
+    uint64_t key = MakeKey(text, font.get());
+
+    auto it = m_Lookup.find(key);
+    if (it != m_Lookup.end())
+    {
+        m_Entries.splice(m_Entries.begin(), m_Entries, it->second);
+
+        Entry& entry = m_Entries.front();
+        if (entry.LayoutFont == font.get() && entry.Text == text)
+            return entry.Layout;
+
+        // Another text with the same key, it is replaced by the one asked for
+        entry.LayoutFont = font.get();
+        entry.Text = text;
+        Build(entry.Layout, text, *font);
+        return entry.Layout;
+    }
+
+    // Once full, the least recently used entry is reused together with the memory it holds
+    if (m_Entries.size() >= m_Capacity)
+    {
+        m_Entries.splice(m_Entries.begin(), m_Entries, std::prev(m_Entries.end()));
+        m_Lookup.erase(m_Entries.front().Key);
+    }
+    else
+    {
+        m_Entries.emplace_front();
+    }
+
+    Entry& entry = m_Entries.front();
+    entry.Key = key;
+    entry.LayoutFont = font.get();
+    entry.Text = text;
+    Build(entry.Layout, text, *font);
+
+    m_Lookup[key] = m_Entries.begin();
+    return entry.Layout;
+}
+
+void TextLayoutCache::Clear()
+{
+    m_Lookup.clear();
+    m_Entries.clear();
+}
+
+uint64_t TextLayoutCache::MakeKey(const std::string& text, const Font* font)
+{
+    uint64_t textHash = std::hash<std::string>{}(text);
+    uint64_t fontHash = std::hash<const Font*>{}(font);
+    return textHash ^ (fontHash + 0x9e3779b97f4a7c15ull + (textHash << 6) + (textHash >> 2));
+}
+
+void TextLayoutCache::Build(TextLayout& layout, const std::string& text, const Font& font)
+{
+    layout.Glyphs.clear();
+    layout.AdvanceSum = 0.0f;
+    layout.MaxGlyphHeight = 0.0f;
+    layout.LineHeight = font.GetCharacter('A').Size.y;
+
+    // Lines are split the same way std::getline would, a trailing new line does not start another line
+    layout.LineCount = text.empty() ? 0 : std::count(text.begin(), text.end(), '\n') + (text.back() == '\n' ? 0 : 1);
+
+    float lineSpacing = layout.LineHeight * (1.0f + FONT_Y_SPACING_RATIO);
+    glm::vec2 pen = glm::vec2(0.0f);
+    size_t lineFirstGlyph = 0;
+
+    for (size_t i = 0; i <= text.size(); i++)
+    {
+        if (i == text.size() || text[i] == '\n')
+        {
+            for (size_t glyph = lineFirstGlyph; glyph < layout.Glyphs.size(); glyph++)
+                layout.Glyphs[glyph].LineWidth = pen.x;
+
+            lineFirstGlyph = layout.Glyphs.size();
+            pen.x = 0.0f;
+            pen.y -= lineSpacing;
+        }
+
+        if (i == text.size())
+            break;
+
+        const Font::Character& ch = font.GetCharacter(text[i]);
+        float advance = ch.Advance >> 6;
+        layout.AdvanceSum += advance;
+        layout.MaxGlyphHeight = glm::max(layout.MaxGlyphHeight, (float)ch.Size.y);
+
+        if (text[i] == '\n')
+            continue;
+
+        if (text[i] != ' ')
+        {
+            layout.Glyphs.push_back({
+                { pen.x + ch.Bearing.x, pen.y - (ch.Size.y - ch.Bearing.y) },
+                glm::vec2(ch.Size),
+                0.0f,
+                ch.TexCoordBottomLeft,
+                ch.TexCoordTopRight
+            });
+        }
+
+        pen.x += advance;
+    }
+}
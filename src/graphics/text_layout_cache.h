@@ -0,0 +1,67 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include <glm/glm.hpp>
+
+#include "graphics/font.h"
+
+// number of text layouts kept, the least recently used one is replaced first
+#define TEXT_LAYOUT_CACHE_CAPACITY 512
+
+// Placement of the glyphs of a text, kept in pixels of the font so one layout serves every scale
+struct TextLayout
+{
+    struct Glyph
+    {
+        glm::vec2 Position;  // bottom left corner relative to the start of the first line
+        glm::vec2 Size;
+        float LineWidth;     // width of the line holding the glyph, used for horizontal alignment
+        glm::vec2 TexCoordBottomLeft;
+        glm::vec2 TexCoordTopRight;
+    };
+
+    std::vector<Glyph> Glyphs;
+    unsigned int LineCount = 0;
+    float LineHeight = 0.0f;
+    // width of the whole text as a single line and its tallest glyph, see Renderer2D::GetTextSize
+    float AdvanceSum = 0.0f;
+    float MaxGlyphHeight = 0.0f;
+};
+
+// Texts drawn or measured again, like static UI labels and tile stats, are laid out only once.
+// Looking up a cached text does not allocate.
+class TextLayoutCache
+{
+public:
+    TextLayoutCache(unsigned int capacity = TEXT_LAYOUT_CACHE_CAPACITY);
+    ~TextLayoutCache() = default;
+
+    const TextLayout& Get(const std::string& text, const std::shared_ptr<Font>& font);
+    void Clear();
+
+    inline unsigned int GetSize() const { return m_Entries.size(); }
+
+private:
+    struct Entry
+    {
+        uint64_t Key;
+        const Font* LayoutFont;
+        std::string Text;
+        TextLayout Layout;
+    };
+
+    static uint64_t MakeKey(const std::string& text, const Font* font);
+    static void Build(TextLayout& layout, const std::string& text, const Font& font);
+
+private:
+    // most recently used entries first
+    std::list<Entry> m_Entries;
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> m_Lookup;
+    unsigned int m_Capacity;
+};
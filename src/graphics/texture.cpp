@@ -1,6 +1,8 @@
 #include "texture.h"
 
 #include "core/logger.h"
+#include "graphics/render_state.h"
+#include "graphics/graphics_context.h"
 
 #include <glad/glad.h>
 
@@ -30,11 +32,27 @@ static unsigned int TextureFilterToGL(TextureFilter filter)
     }
 }
 
+unsigned int Texture2D::s_NextHandle = 1;
+
 Texture2D::Texture2D(const TextureData& data)
-    : m_Width(data.Size.x), m_Height(data.Size.y), m_TextureTarget(data.IsMultisample ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D)
+    : m_Width(data.Size.x), m_Height(data.Size.y), m_TextureID(0), m_Handle(s_NextHandle++),
+      m_TextureTarget(data.IsMultisample ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D)
 {
+    m_Format = GL_RGB;
+    if (data.NrChannels == 1)
+        m_Format = GL_RED;
+    else if (data.NrChannels == 3)
+        m_Format = GL_RGB;
+    else if (data.NrChannels == 4)
+        m_Format = GL_RGBA;
+    else
+        LOG_ERROR("Texture: Unsupported texture format");
+
+    if (!GraphicsContext::IsAvailable())
+        return;
+
     glGenTextures(1, &m_TextureID);
-    glBindTexture(m_TextureTarget, m_TextureID);
+    RenderState::BindTexture(RenderState::GetActiveTextureUnit(), m_TextureTarget, m_TextureID);
 
     glTexParameteri(m_TextureTarget, GL_TEXTURE_WRAP_S, TextureWrapToGL(data.WrapHorizontal));
     glTexParameteri(m_TextureTarget, GL_TEXTURE_WRAP_T, TextureWrapToGL(data.WrapVertical));
@@ -43,37 +61,66 @@ Texture2D::Texture2D(const TextureData& data)
 
     glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, &data.BorderColor[0]);
 
-    int format;
-    if (data.NrChannels == 1)
-        format = GL_RED;
-    else if (data.NrChannels == 3)
-        format = GL_RGB;
-    else if (data.NrChannels == 4)
-        format = GL_RGBA;
-    else
-        LOG_ERROR("Texture: Unsupported texture format");
-
     if (m_TextureTarget == GL_TEXTURE_2D_MULTISAMPLE)
-        glTexImage2DMultisample(m_TextureTarget, 4, format, m_Width, m_Height, GL_TRUE);
+        glTexImage2DMultisample(m_TextureTarget, 4, m_Format, m_Width, m_Height, GL_TRUE);
     else
-        glTexImage2D(m_TextureTarget, 0, format, m_Width, m_Height, 0, format, GL_UNSIGNED_BYTE, data.Data);
+        glTexImage2D(m_TextureTarget, 0, m_Format, m_Width, m_Height, 0, m_Format, GL_UNSIGNED_BYTE, data.Data);
+
+    // Single channel masks are sampled as white with the mask in alpha, so they can be tinted like any other texture
+    if (data.IsAlphaMask && data.NrChannels == 1)
+    {
+        int swizzle[4] = { GL_ONE, GL_ONE, GL_ONE, GL_RED };
+        glTexParameteriv(m_TextureTarget, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+    }
 
     glGenerateMipmap(m_TextureTarget);
-    glBindTexture(m_TextureTarget, 0);
+    RenderState::BindTexture(RenderState::GetActiveTextureUnit(), m_TextureTarget, 0);
+}
+
+Texture2D::Texture2D(const std::shared_ptr<Texture2D>& atlas, const glm::ivec2& size,
+                     const glm::vec2& texCoordBottomLeft, const glm::vec2& texCoordTopRight)
+    : m_Width(size.x), m_Height(size.y), m_TextureID(atlas->m_TextureID), m_Handle(atlas->m_Handle), m_TextureTarget(atlas->m_TextureTarget),
+      m_Format(atlas->m_Format), m_Atlas(atlas), m_TexCoordBottomLeft(texCoordBottomLeft), m_TexCoordTopRight(texCoordTopRight)
+{
 }
 
 Texture2D::~Texture2D()
 {
+    // The texture object of a region belongs to its atlas
+    if (m_Atlas || !GraphicsContext::IsAvailable())
+        return;
+
     glDeleteTextures(1, &m_TextureID);
+    RenderState::OnTextureDeleted(m_TextureID);
 }
 
 void Texture2D::Bind(unsigned int unit) const
 {
-    glActiveTexture(GL_TEXTURE0 + unit);
-    glBindTexture(m_TextureTarget, m_TextureID);
+    RenderState::BindTexture(unit, m_TextureTarget, m_TextureID);
 }
 
 void Texture2D::Unbind() const
 {
-    glBindTexture(m_TextureTarget, 0);
+    RenderState::BindTexture(RenderState::GetActiveTextureUnit(), m_TextureTarget, 0);
+}
+
+void Texture2D::SetData(const unsigned char* data)
+{
+    if (m_TextureTarget == GL_TEXTURE_2D_MULTISAMPLE)
+    {
+        LOG_WARN("Texture2D::SetData: multisampled textures can only be rendered into");
+        return;
+    }
+
+    if (m_Atlas)
+    {
+        LOG_WARN("Texture2D::SetData: regions of an atlas cannot be replaced on their own");
+        return;
+    }
+
+    if (!GraphicsContext::IsAvailable())
+        return;
+
+    RenderState::BindTexture(RenderState::GetActiveTextureUnit(), m_TextureTarget, m_TextureID);
+    glTexSubImage2D(m_TextureTarget, 0, 0, 0, m_Width, m_Height, m_Format, GL_UNSIGNED_BYTE, data);
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <memory>
+
 #include <glm/glm.hpp>
 
 enum class TextureWrap
@@ -28,6 +30,7 @@ struct TextureData
     TextureFilter MinFilter = TextureFilter::LINEAR;
     TextureFilter MagFilter = TextureFilter::LINEAR;
     bool IsMultisample = false;
+    bool IsAlphaMask = false;
     glm::vec4 BorderColor = { 1.0f, 0.0f, 1.0f, 0.0f };
 };
 
@@ -35,17 +38,38 @@ class Texture2D
 {
 public:
     Texture2D(const TextureData& data);
+    // Region of an atlas, Renderer2D draws it with the atlas bound and its texture coordinates remapped to the region
+    Texture2D(const std::shared_ptr<Texture2D>& atlas, const glm::ivec2& size,
+              const glm::vec2& texCoordBottomLeft, const glm::vec2& texCoordTopRight);
     ~Texture2D();
 
     inline unsigned int GetWidth() const { return m_Width; }
     inline unsigned int GetHeight() const { return m_Height; }
     inline unsigned int GetID() const { return m_TextureID; }
+    // Process-wide number of the texture, unlike the GL name it is also given out without a context. Regions share the one of their atlas.
+    inline unsigned int GetHandle() const { return m_Handle; }
+
+    inline bool IsSubTexture() const { return m_Atlas != nullptr; }
+    inline const std::shared_ptr<Texture2D>& GetAtlas() const { return m_Atlas; }
+    inline const glm::vec2& GetTexCoordBottomLeft() const { return m_TexCoordBottomLeft; }
+    inline const glm::vec2& GetTexCoordTopRight() const { return m_TexCoordTopRight; }
 
     void Bind(unsigned int unit) const;
     void Unbind() const;
 
+    // Replaces the whole image, data has to match the size and channel count the texture was created with
+    void SetData(const unsigned char* data);
+
 private:
     unsigned int m_Width, m_Height;
     unsigned int m_TextureID;
+    unsigned int m_Handle;
     unsigned int m_TextureTarget;
+    int m_Format;
+
+    std::shared_ptr<Texture2D> m_Atlas;
+    glm::vec2 m_TexCoordBottomLeft = glm::vec2(0.0f);
+    glm::vec2 m_TexCoordTopRight = glm::vec2(1.0f);
+
+    static unsigned int s_NextHandle;
 };
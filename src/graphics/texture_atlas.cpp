@@ -0,0 +1,106 @@
+#include "texture_atlas.h"
+
+#include <cstring>
+#include <algorithm>
+
+#include "core/logger.h"
+
+void TextureAtlasBuilder::Add(const std::string& name, const glm::ivec2& size, const unsigned char* pixels)
+{
+    if (size.x + TEXTURE_ATLAS_PADDING * 2 > TEXTURE_ATLAS_MAX_SIZE || size.y + TEXTURE_ATLAS_PADDING * 2 > TEXTURE_ATLAS_MAX_SIZE)
+    {
+        LOG_ERROR("TextureAtlasBuilder::Add: image {0} of {1}x{2}px does not fit into an atlas", name, size.x, size.y);
+        return;
+    }
+
+    Image image = { name, size, std::vector<unsigned char>(pixels, pixels + size.x * size.y * 4), glm::ivec2(0), 0 };
+    m_Images.push_back(std::move(image));
+}
+
+std::unordered_map<std::string, std::shared_ptr<Texture2D>> TextureAtlasBuilder::Build()
+{
+    std::unordered_map<std::string, std::shared_ptr<Texture2D>> regions;
+    if (m_Images.empty())
+        return regions;
+
+    // Shelves fill up best with the tallest images placed first
+    std::stable_sort(m_Images.begin(), m_Images.end(), [](const Image& a, const Image& b) {
+        return a.Size.y > b.Size.y;
+    });
+
+    unsigned int page = 0;
+    glm::ivec2 pen = { TEXTURE_ATLAS_PADDING, TEXTURE_ATLAS_PADDING };
+    int rowHeight = 0;
+
+    for (auto& image : m_Images)
+    {
+        if (pen.x + image.Size.x + TEXTURE_ATLAS_PADDING > TEXTURE_ATLAS_MAX_SIZE)
+        {
+            pen.x = TEXTURE_ATLAS_PADDING;
+            pen.y += rowHeight + TEXTURE_ATLAS_PADDING;
+            rowHeight = 0;
+        }
+
+        if (pen.y + image.Size.y + TEXTURE_ATLAS_PADDING > TEXTURE_ATLAS_MAX_SIZE)
+        {
+            BuildPage(page++, pen.y, regions);
+            pen = { TEXTURE_ATLAS_PADDING, TEXTURE_ATLAS_PADDING };
+        }
+
+        image.Offset = pen;
+        image.Page = page;
+
+        pen.x += image.Size.x + TEXTURE_ATLAS_PADDING;
+        rowHeight = glm::max(rowHeight, image.Size.y);
+    }
+
+    BuildPage(page, pen.y + rowHeight + TEXTURE_ATLAS_PADDING, regions);
+
+    LOG_INFO("TextureAtlasBuilder: packed {0} images into {1} atlas page(s)", m_Images.size(), page + 1);
+    m_Images.clear();
+    return regions;
+}
+
+void TextureAtlasBuilder::BuildPage(unsigned int page, int height, std::unordered_map<std::string, std::shared_ptr<Texture2D>>& regions)
+{
+    int width = TEXTURE_ATLAS_MAX_SIZE;
+    std::vector<unsigned char> pixels(width * height * 4, 0);
+
+    for (const auto& image : m_Images)
+    {
+        if (image.Page != page)
+            continue;
+
+        for (int row = 0; row < image.Size.y; row++)
+        {
+            std::memcpy(
+                pixels.data() + ((image.Offset.y + row) * width + image.Offset.x) * 4,
+                image.Pixels.data() + row * image.Size.x * 4,
+                image.Size.x * 4
+            );
+        }
+    }
+
+    TextureData data = {
+        { width, height },
+        pixels.data(),
+        4u,
+        TextureWrap::CLAMP_TO_EDGE,
+        TextureWrap::CLAMP_TO_EDGE
+    };
+    auto atlas = std::make_shared<Texture2D>(data);
+
+    // Rows are stored bottom to top like in every loaded texture, so the offset is also the bottom left corner
+    for (const auto& image : m_Images)
+    {
+        if (image.Page != page)
+            continue;
+
+        regions[image.Name] = std::make_shared<Texture2D>(
+            atlas,
+            image.Size,
+            glm::vec2(image.Offset) / glm::vec2(width, height),
+            glm::vec2(image.Offset + image.Size) / glm::vec2(width, height)
+        );
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <string>
+#include <memory>
+#include <vector>
+#include <unordered_map>
+
+#include <glm/glm.hpp>
+
+#include "graphics/texture.h"
+
+// largest side of an atlas page in pixels, sprites that do not fit start another page
+#define TEXTURE_ATLAS_MAX_SIZE 2048
+// empty pixels kept around each sprite so filtering does not pick up its neighbours
+#define TEXTURE_ATLAS_PADDING 2
+
+// Packs small RGBA images into as few textures as possible, so sprites drawn together share one texture slot
+class TextureAtlasBuilder
+{
+public:
+    TextureAtlasBuilder() = default;
+    ~TextureAtlasBuilder() = default;
+
+    // Copies the image, pixels are expected with 4 channels and rows ordered bottom to top
+    void Add(const std::string& name, const glm::ivec2& size, const unsigned char* pixels);
+    // Packs every added image and returns a region of an atlas page for each of them by name
+    std::unordered_map<std::string, std::shared_ptr<Texture2D>> Build();
+
+    inline bool IsEmpty() const { return m_Images.empty(); }
+
+private:
+    struct Image
+    {
+        std::string Name;
+        glm::ivec2 Size;
+        std::vector<unsigned char> Pixels;
+        glm::ivec2 Offset;
+        unsigned int Page;
+    };
+
+    void BuildPage(unsigned int page, int height, std::unordered_map<std::string, std::shared_ptr<Texture2D>>& regions);
+
+private:
+    std::vector<Image> m_Images;
+};
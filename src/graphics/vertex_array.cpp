@@ -2,32 +2,58 @@
 
 #include <glad/glad.h>
 
+#include "graphics/render_state.h"
+#include "graphics/graphics_context.h"
+
 VertexArray::VertexArray(const std::shared_ptr<VertexBuffer>& vertexBuffer,
                          const std::shared_ptr<IndexBuffer>& indexBuffer,
                          const std::vector<int>& layout)
-    : m_VertexBuffer(vertexBuffer), m_IndexBuffer(indexBuffer)
+    : m_VertexBuffer(vertexBuffer), m_IndexBuffer(indexBuffer), m_AttributeCount(layout.size()), m_ArrayID(0)
 {
+    if (!GraphicsContext::IsAvailable())
+        return;
+
     glGenVertexArrays(1, &m_ArrayID);
-    glBindVertexArray(m_ArrayID);
+    RenderState::BindVertexArray(m_ArrayID);
 
     vertexBuffer->Bind();
     vertexBuffer->SetLayout(layout);
     indexBuffer->Bind();
 
-    glBindVertexArray(0);
+    RenderState::BindVertexArray(0);
 }
 
 VertexArray::~VertexArray()
 {
+    if (!GraphicsContext::IsAvailable())
+        return;
+
     glDeleteVertexArrays(1, &m_ArrayID);
+    RenderState::OnVertexArrayDeleted(m_ArrayID);
 }
 
 void VertexArray::Bind() const
 {
-    glBindVertexArray(m_ArrayID);
+    RenderState::BindVertexArray(m_ArrayID);
 }
 
 void VertexArray::Unbind() const
 {
-    glBindVertexArray(0);
+    RenderState::BindVertexArray(0);
+}
+
+// Per-instance attributes are placed right after the per-vertex ones
+void VertexArray::SetInstanceBuffer(const std::shared_ptr<VertexBuffer>& instanceBuffer, const std::vector<int>& layout)
+{
+    m_InstanceBuffer = instanceBuffer;
+
+    if (!GraphicsContext::IsAvailable())
+        return;
+
+    RenderState::BindVertexArray(m_ArrayID);
+
+    instanceBuffer->Bind();
+    instanceBuffer->SetLayout(layout, m_AttributeCount, 1);
+
+    RenderState::BindVertexArray(0);
 }
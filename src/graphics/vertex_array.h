@@ -15,11 +15,16 @@ public:
     void Bind() const;
     void Unbind() const;
 
+    void SetInstanceBuffer(const std::shared_ptr<VertexBuffer>& instanceBuffer, const std::vector<int>& layout);
+
     inline const std::shared_ptr<VertexBuffer>& GetVertexBuffer() const { return m_VertexBuffer; }
+    inline const std::shared_ptr<VertexBuffer>& GetInstanceBuffer() const { return m_InstanceBuffer; }
     inline const std::shared_ptr<IndexBuffer>& GetIndexBuffer() const { return m_IndexBuffer; }
 
 private:
     std::shared_ptr<VertexBuffer> m_VertexBuffer;
+    std::shared_ptr<VertexBuffer> m_InstanceBuffer;
     std::shared_ptr<IndexBuffer> m_IndexBuffer;
+    unsigned int m_AttributeCount;
     unsigned int m_ArrayID;
 };
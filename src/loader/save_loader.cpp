@@ -399,7 +399,7 @@ std::shared_ptr<GameLayer> SaveLoader::ConstructGameLayer(const _SaveData& data)
                 auto tile = gameMap->GetTile(x, y);
                 for (const auto& unitGroup : it->UnitGroupData)
                 {
-                    UnitGroup ug(unitGroup.Type, new UnitStats(unitGroup.Stats));
+                    UnitGroup ug(unitGroup.Type, unitGroup.Stats);
                     ug.SetMovedOnIteration(unitGroup.MovedOnIteration);
 
                     tile->CreateUnitGroup(ug);
@@ -1,9 +1,19 @@
 #include "core/application.h"
+#include "game/unit.h"
+#include "game/building.h"
 
 int main(int argc, char* argv[])
 {
     std::unique_ptr<Application> app = std::make_unique<Application>();
     app->Run();
+    app.reset();
+
+#if defined(DEBUG)
+    // Every game layer is gone by now together with its tiles, so pooled objects still alive were leaked
+    UnitStatsPool.ReportLeaks();
+    UnitGroupPool.ReportLeaks();
+    BuildingPool.ReportLeaks();
+#endif
 
     return 0;
 }
@@ -18,7 +18,7 @@ ChoosePlayersView::ChoosePlayersView()
     m_GameMapManager = std::make_shared<GameMapManager>("");
     m_MapCameraController = std::make_shared<OrthographicCameraController>(m_MapDrawData.Size.x / m_MapDrawData.Size.y);
     auto mapPixelSize = m_Camera->ConvertRelativeSizeToPixel(m_MapDrawData.Size);
-    m_Framebuffer = std::make_unique<FrameBuffer>((unsigned int)mapPixelSize.x, (unsigned int)mapPixelSize.y);
+    m_Framebuffer = std::make_shared<FrameBuffer>((unsigned int)mapPixelSize.x, (unsigned int)mapPixelSize.y);
 
     m_NextPlayerInfo.Color = Util::GetRandomColor();
 
@@ -133,27 +133,20 @@ bool ChoosePlayersView::OnMouseButtonPressed(MouseButtonPressedEvent& event)
 
             glm::vec2 mapMousePos = CalculateMousePositionOnMap();
 
-            for (int y = 0; y < m_GameMapManager->GetGameMap()->GetTileCountY(); y++)
+            auto tile = m_GameMapManager->GetGameMap()->FindTile(mapMousePos);
+            if (tile && tile->AssetsCanExist())
             {
-                for (int x = 0; x < m_GameMapManager->GetGameMap()->GetTileCountX(); x++)
+                m_SelectedTile.Selected = true;
+                m_SelectedTile.TileRef = tile;
+                m_NextPlayerInfo.Color = Util::GetRandomColor();
+                m_UsernameInputBox->SetFocused(true);
+                for (auto player : m_PlayersData)
                 {
-                    auto tile = m_GameMapManager->GetGameMap()->GetTile(x, y);
-
-                    if (tile->InRange(mapMousePos) && tile->AssetsCanExist())
-                    {
-                        m_SelectedTile.Selected = true;
-                        m_SelectedTile.TileRef = tile;
-                        m_NextPlayerInfo.Color = Util::GetRandomColor();
-                        m_UsernameInputBox->SetFocused(true);
-                        for (auto player : m_PlayersData)
-                        {
-                            if (player.first == tile->GetPosition())
-                                m_UsernameInputBox->SetText(player.second.Player.Name);
-                        }
-
-                        return true;
-                    }
+                    if (player.first == tile->GetPosition())
+                        m_UsernameInputBox->SetText(player.second.Player.Name);
                 }
+
+                return true;
             }
 
             m_SelectedTile.Selected = false;
@@ -460,7 +453,7 @@ void ChoosePlayersView::DrawMapPreviewColumn(float dt)
 {
     Renderer2D::EndScene();
 
-    m_Framebuffer->Bind();
+    Renderer2D::BeginRenderTarget(m_Framebuffer);
 
     Renderer2D::ClearColor({0.0f, 0.0f, 0.0f, 1.0f});
 
@@ -476,12 +469,13 @@ void ChoosePlayersView::DrawMapPreviewColumn(float dt)
         mapMousePos = CalculateMousePositionOnMap();
     }
 
+    auto hoveredTile = mouseOnMap ? m_GameMapManager->GetGameMap()->FindTile(mapMousePos) : nullptr;
     for (int y = 0; y < m_GameMapManager->GetGameMap()->GetTileCountY(); y++)
     {
         for (int x = 0; x < m_GameMapManager->GetGameMap()->GetTileCountX(); x++)
         {
             auto tile = m_GameMapManager->GetGameMap()->GetTile(x, y);
-            bool isCursorOnTile = mouseOnMap && tile->InRange(mapMousePos);
+            bool isCursorOnTile = tile == hoveredTile;
             if (tile->AssetsCanExist())
             {
                 glm::vec3 color;
@@ -517,11 +511,10 @@ void ChoosePlayersView::DrawMapPreviewColumn(float dt)
         }
     }
 
-    m_Framebuffer->PostProcess();
-    m_Framebuffer->Unbind();
-
     Renderer2D::EndScene();
 
+    Renderer2D::EndRenderTarget();
+
     Renderer2D::BeginScene(m_Camera);
 
     // Draw the map
@@ -539,7 +532,7 @@ void ChoosePlayersView::OnWindowSizeChanged()
 
     auto mapPixelSize = m_Camera->ConvertRelativeSizeToPixel(m_MapDrawData.Size);
     mapPixelSize = Util::Clamp<glm::vec2>(mapPixelSize, glm::vec2(1.0f), mapPixelSize);
-    m_Framebuffer = std::make_unique<FrameBuffer>((unsigned int)mapPixelSize.x, (unsigned int)mapPixelSize.y);
+    m_Framebuffer = std::make_shared<FrameBuffer>((unsigned int)mapPixelSize.x, (unsigned int)mapPixelSize.y);
 
     m_MapCameraController->GetCamera()->SetAspectRatio(m_MapDrawData.Size.x / m_MapDrawData.Size.y);
 
@@ -87,7 +87,7 @@ private:
     struct
     {
         bool Selected = false;
-        std::shared_ptr<Tile> TileRef;
+        Tile* TileRef = nullptr;
     } m_SelectedTile;
 
     struct
@@ -107,7 +107,7 @@ private:
 
     glm::vec2 m_MapZoom;
 
-    std::unique_ptr<FrameBuffer> m_Framebuffer;
+    std::shared_ptr<FrameBuffer> m_Framebuffer;
     std::shared_ptr<GameMapManager> m_GameMapManager;
     std::shared_ptr<OrthographicCameraController> m_MapCameraController;
 };
@@ -252,7 +252,8 @@ void GameInfo::DrawBuildingUpgradeInfo()
     };
 
     auto info = GameLayer::Get().GetBuildingUpgradeInfo();
-    if (info.Show)
+    Building* building = BuildingPool.Get(info.BuildingHandle);
+    if (info.Show && building)
     {
         // draw background
         Renderer2D::DrawQuad(position, size, glm::vec4(0.0f, 0.0f, 0.0f, 0.8f));
@@ -270,7 +271,7 @@ void GameInfo::DrawBuildingUpgradeInfo()
 
         // draw resources
         Resources::Draw2x2(
-            info._Building->GetUpgradeCost(),
+            building->GetUpgradeCost(),
             { position.x, position.y + 0.02f }
         );
     }
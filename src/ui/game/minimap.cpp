@@ -34,7 +34,7 @@ Minimap::Minimap(const std::shared_ptr<OrthographicCamera>& UICamera,
     float zoom = glm::max(mapZoom.x / gameCamera->GetAspectRatio(), mapZoom.y);
     m_MinimapCamera->SetZoom(zoom);
 
-    m_Framebuffer = std::make_unique<FrameBuffer>((unsigned int)pixelSize.x, (unsigned int)pixelSize.y);
+    m_Framebuffer = std::make_shared<FrameBuffer>((unsigned int)pixelSize.x, (unsigned int)pixelSize.y);
 
     m_MapSize = m_MinimapCamera->CalculateRelativeWindowSize();
 
@@ -76,52 +76,68 @@ void Minimap::Draw()
         }
     }
 
-    m_Framebuffer->Bind();
+    // Tiles only change color when their ownership changes, so they stay cached in the framebuffer until then
+    if (m_MapDirty || m_DrawnOwnershipVersion != Tile::s_OwnershipVersion ||
+        m_DrawnGameMap != m_GameMapManager->GetGameMap())
+    {
+        RedrawMap();
+    }
+
+    Renderer2D::BeginScene(m_UICamera);
+
+    m_NextTurnButton->OnUpdate();
+    Renderer2D::DrawQuad(m_MinimapPos, m_Size, m_Framebuffer->GetTexture());
+
+    // Game camera viewport is mapped from map coordinates onto the minimap
+    glm::vec2 mapToMinimapScale = m_Size / m_MapSize;
+    glm::vec2 viewportPos = m_MinimapPos + (glm::vec2(m_GameCamera->GetPosition()) - glm::vec2(m_MinimapCamera->GetPosition())) * mapToMinimapScale;
+    glm::vec2 viewportSize = m_GameCamera->CalculateRelativeWindowSize() * mapToMinimapScale;
+
+    Renderer2D::BeginClip(m_MinimapPos, m_Size);
+#if defined(DEBUG)
+    Renderer2D::DrawQuad(viewportPos, viewportSize, glm::vec4(1.0f), DebugData::Get()->MinimapData.BorderThickness);
+#else
+    Renderer2D::DrawQuad(viewportPos, viewportSize, glm::vec4(1.0f), 5.0);
+#endif
+    Renderer2D::EndClip();
+
+    Renderer2D::EndScene();
+}
+
+void Minimap::RedrawMap()
+{
+    Renderer2D::BeginRenderTarget(m_Framebuffer);
 
     Renderer2D::ClearColor({0.0f, 0.0f, 0.0f, 0.0f});
 
     Renderer2D::BeginScene(m_MinimapCamera);
-    for (int y = 0; y < m_GameMapManager->GetGameMap()->GetTileCountY(); y++)
+    for (auto& tile : m_GameMapManager->GetGameMap()->GetTiles())
     {
-        for (int x = 0; x < m_GameMapManager->GetGameMap()->GetTileCountX(); x++)
+        if (tile.AssetsCanExist())
         {
-            auto tile = m_GameMapManager->GetGameMap()->GetTile(x, y);
-            if (tile->AssetsCanExist())
-            {
-                glm::vec4 color = ColorData::Get().TileColors.MiniMapColor;
-
-                auto ownedBy = tile->GetOwnedBy();
-                if (ownedBy.get())
-                {
-                    color = { ownedBy->GetColor(), 1.0f };
-                }
+            glm::vec4 color = ColorData::Get().TileColors.MiniMapColor;
 
-                Renderer2D::DrawHexagon(tile->GetPosition(), glm::vec2(1.0f), color);
-            }
-            else if (tile->GetEnvironment() == TileEnvironment::OCEAN)
+            auto ownedBy = tile.GetOwnedBy();
+            if (ownedBy)
             {
-                Renderer2D::DrawHexagon(tile->GetPosition(), glm::vec2(1.0f), glm::vec4(0.2f, 0.5f, 0.8f, 1.0f));
+                color = { ownedBy->GetColor(), 1.0f };
             }
+
+            Renderer2D::DrawHexagon(tile.GetPosition(), glm::vec2(1.0f), color);
+        }
+        else if (tile.GetEnvironment() == TileEnvironment::OCEAN)
+        {
+            Renderer2D::DrawHexagon(tile.GetPosition(), glm::vec2(1.0f), glm::vec4(0.2f, 0.5f, 0.8f, 1.0f));
         }
     }
 
-#if defined(DEBUG)
-    Renderer2D::DrawQuad(m_GameCamera->GetPosition(), m_GameCamera->CalculateRelativeWindowSize(), glm::vec4(1.0f), DebugData::Get()->MinimapData.BorderThickness);
-#else
-    Renderer2D::DrawQuad(m_GameCamera->GetPosition(), m_GameCamera->CalculateRelativeWindowSize(), glm::vec4(1.0f), 5.0);
-#endif
-
     Renderer2D::EndScene();
 
-    m_Framebuffer->PostProcess();
-    m_Framebuffer->Unbind();
-
-    Renderer2D::BeginScene(m_UICamera);
-
-    m_NextTurnButton->OnUpdate();
-    Renderer2D::DrawQuad(m_MinimapPos, m_Size, m_Framebuffer->GetTexture());
+    Renderer2D::EndRenderTarget();
 
-    Renderer2D::EndScene();
+    m_MapDirty = false;
+    m_DrawnOwnershipVersion = Tile::s_OwnershipVersion;
+    m_DrawnGameMap = m_GameMapManager->GetGameMap();
 }
 
 bool Minimap::OnWindowResized(WindowResizedEvent& event)
@@ -129,6 +145,7 @@ bool Minimap::OnWindowResized(WindowResizedEvent& event)
     m_Position = m_UICamera->CalculateRelativeBottomLeftPosition() + m_Offset;
     m_MinimapPos = m_Position + m_Size * 0.5f;
     m_NextTurnButton->SetPosition({m_MinimapPos.x, m_MinimapPos.y + (m_Size.y + m_NextTurnButtonHeight) / 2});
+    m_MapDirty = true;
     return false;
 }
 
@@ -32,15 +32,19 @@ private:
     bool OnMouseScrolled(MouseScrolledEvent& event);
     bool OnMouseButtonPressed(MouseButtonPressedEvent& event);
     void MoveCameraToClickLocation();
+    void RedrawMap();
 
     void OnNextTurnButtonPressed(ButtonCallbackData data);
 private:
     bool m_MouseWasPressed = false;
+    bool m_MapDirty = true;
+    unsigned int m_DrawnOwnershipVersion = 0;
+    std::shared_ptr<GameMap> m_DrawnGameMap;
     float m_NextTurnButtonHeight = 0.1f;
     glm::vec2 m_Offset;
     glm::vec2 m_MinimapPos;
     glm::vec2 m_MapSize;
-    std::unique_ptr<FrameBuffer> m_Framebuffer;
+    std::shared_ptr<FrameBuffer> m_Framebuffer;
     std::shared_ptr<OrthographicCamera> m_GameCamera;
     std::shared_ptr<OrthographicCamera> m_MinimapCamera;
     std::shared_ptr<GameMapManager> m_GameMapManager;
@@ -93,45 +93,37 @@ void ShopPanel::ProcessInvalidAssetPlacement(const glm::vec2& cursorPos)
 {
     static auto crossTexture = ResourceManager::GetTexture("cross");
 
-    auto relMousePos = GameLayer::Get().GetCameraController()->GetCamera()->CalculateRelativeMousePosition();
     auto currentPlayer = GameLayer::Get().GetPlayerManager()->GetCurrentPlayer();
-    auto gameMap = GameLayer::Get().GetGameMapManager()->GetGameMap();
+    auto tile = GameLayer::Get().GetHoveredTile();
 
-    for (int y = 0; y < gameMap->GetTileCountY(); y++)
+    if (tile)
     {
-        for (int x = 0; x < gameMap->GetTileCountX(); x++)
+        if (tile->GetOwnedBy() == currentPlayer.get())
         {
-            auto tile = gameMap->GetTile(x, y);
-            if (tile->InRange(relMousePos))
+            if (m_CursorAttachedAsset.UnitGroupType != UnitGroupType::NONE &&
+               (!tile->HasSpaceForUnitGroups(1) || !tile->CanRecruitUnitGroup(m_CursorAttachedAsset.UnitGroupType)) ||
+                m_CursorAttachedAsset.BuildingType != BuildingType::NONE && !tile->HasSpaceForBuildings(1) ||
+                !tile->AssetsCanExist())
             {
-                if (tile->GetOwnedBy() == currentPlayer)
-                {
-                    if (m_CursorAttachedAsset.UnitGroupType != UnitGroupType::NONE &&
-                       (!tile->HasSpaceForUnitGroups(1) || !tile->CanRecruitUnitGroup(m_CursorAttachedAsset.UnitGroupType)) ||
-                        m_CursorAttachedAsset.BuildingType != BuildingType::NONE && !tile->HasSpaceForBuildings(1) ||
-                        !tile->AssetsCanExist())
-                    {
-                        Renderer2D::DrawQuad(cursorPos, glm::vec2(m_AssetPriceSize * 0.5f), crossTexture);
-                    }
-                }
-                else
+                Renderer2D::DrawQuad(cursorPos, glm::vec2(m_AssetPriceSize * 0.5f), crossTexture);
+            }
+        }
+        else
+        {
+            if (m_CursorAttachedAsset.PotionType != PotionType::NONE)
+            {
+                if (!tile->AssetsCanExist())
                 {
-                    if (m_CursorAttachedAsset.PotionType != PotionType::NONE)
-                    {
-                        if (!tile->AssetsCanExist())
-                        {
-                            Renderer2D::DrawQuad(cursorPos, glm::vec2(m_AssetPriceSize * 0.5f), crossTexture);
-                        }
-                    }
-                    else
-                    {
-                        Renderer2D::DrawQuad(cursorPos, glm::vec2(m_AssetPriceSize * 0.5f), crossTexture);
-                    }
+                    Renderer2D::DrawQuad(cursorPos, glm::vec2(m_AssetPriceSize * 0.5f), crossTexture);
                 }
-
-                return;
+            }
+            else
+            {
+                Renderer2D::DrawQuad(cursorPos, glm::vec2(m_AssetPriceSize * 0.5f), crossTexture);
             }
         }
+
+        return;
     }
 
     Renderer2D::DrawQuad(cursorPos, glm::vec2(m_AssetPriceSize * 0.5f), crossTexture);
@@ -457,54 +449,44 @@ bool ShopPanel::OnMouseButtonPressedGame(MouseButtonPressedEvent& event)
     {
         case GLFW_MOUSE_BUTTON_LEFT:
         {
-            auto relMousePos = GameLayer::Get().GetCameraController()->GetCamera()->CalculateRelativeMousePosition();
             auto currentPlayer = GameLayer::Get().GetPlayerManager()->GetCurrentPlayer();
-            auto gameMap = GameLayer::Get().GetGameMapManager()->GetGameMap();
+            auto tile = GameLayer::Get().GetHoveredTile();
+            if (!tile)
+                return false;
 
-            for (int y = 0; y < gameMap->GetTileCountY(); y++)
+            if (tile->GetOwnedBy() == currentPlayer.get())
             {
-                for (int x = 0; x < gameMap->GetTileCountX(); x++)
+                if (m_CursorAttachedAsset.UnitGroupType != UnitGroupType::NONE &&
+                    tile->CanRecruitUnitGroup(m_CursorAttachedAsset.UnitGroupType) &&
+                    tile->HasSpaceForUnitGroups(1) &&
+                    currentPlayer->SubtractResources(UnitGroupDataMap[m_CursorAttachedAsset.UnitGroupType].Cost))
                 {
-                    auto tile = gameMap->GetTile(x, y);
-                    if (tile->InRange(relMousePos))
-                    {
-                        if (tile->GetOwnedBy() == currentPlayer)
-                        {
-                            if (m_CursorAttachedAsset.UnitGroupType != UnitGroupType::NONE &&
-                                tile->CanRecruitUnitGroup(m_CursorAttachedAsset.UnitGroupType) &&
-                                tile->HasSpaceForUnitGroups(1) &&
-                                currentPlayer->SubtractResources(UnitGroupDataMap[m_CursorAttachedAsset.UnitGroupType].Cost))
-                            {
-                                tile->CreateUnitGroup(m_CursorAttachedAsset.UnitGroupType);
-                                return true;
-                            }
-                            else if (m_CursorAttachedAsset.BuildingType != BuildingType::NONE &&
-                                     tile->HasSpaceForBuildings(1) &&
-                                     currentPlayer->SubtractResources(BuildingDataMap[m_CursorAttachedAsset.BuildingType].Cost))
-                            {
-                                tile->CreateBuilding(m_CursorAttachedAsset.BuildingType);
-                                return true;
-                            }
-                        }
-
-                        return HandlePotionPurchase(tile, currentPlayer);
-                    }
+                    tile->CreateUnitGroup(m_CursorAttachedAsset.UnitGroupType);
+                    return true;
+                }
+                else if (m_CursorAttachedAsset.BuildingType != BuildingType::NONE &&
+                         tile->HasSpaceForBuildings(1) &&
+                         currentPlayer->SubtractResources(BuildingDataMap[m_CursorAttachedAsset.BuildingType].Cost))
+                {
+                    tile->CreateBuilding(m_CursorAttachedAsset.BuildingType);
+                    return true;
                 }
             }
-            return false;
+
+            return HandlePotionPurchase(tile, currentPlayer);
         }
         default:
             return false;
     }
 }
 
-bool ShopPanel::HandlePotionPurchase(std::shared_ptr<Tile>& tile, std::shared_ptr<Player>& currentPlayer)
+bool ShopPanel::HandlePotionPurchase(Tile* tile, std::shared_ptr<Player>& currentPlayer)
 {
     if (m_CursorAttachedAsset.PotionType == PotionType::NONE || !tile->AssetsCanExist())
         return false;
 
-    auto potion = tile->GetPotion();
-    if (potion->IsApplied())
+    auto& potion = tile->GetPotion();
+    if (potion.IsApplied())
     {
         Notification::Create("Tile already has applied potion", NotificationLevel::INFO);
     }
@@ -512,13 +494,14 @@ bool ShopPanel::HandlePotionPurchase(std::shared_ptr<Tile>& tile, std::shared_pt
     {
         if (currentPlayer->SubtractResources(PotionDataMap[m_CursorAttachedAsset.PotionType].Cost))
         {
-            if (potion->Apply(m_CursorAttachedAsset.PotionType))
+            if (potion.Apply(m_CursorAttachedAsset.PotionType))
             {
+                Tile::s_StateVersion++;
                 return true;
             }
             else
             {
-                int value = potion->GetCooldown(m_CursorAttachedAsset.PotionType);
+                int value = potion.GetCooldown(m_CursorAttachedAsset.PotionType);
                 std::ostringstream oss;
                 oss << Util::ReplaceChar(PotionDataMap[m_CursorAttachedAsset.PotionType].TextureName, '_', ' ');
                 oss << " potion has cooldown value " << value;
@@ -45,7 +45,7 @@ private:
     void DrawPotions(const glm::vec2& cursorPos);
     void DrawAssetInfo(const std::string& textureName, const Resources& cost,
                        std::optional<BuildingType> requiredBuilding = std::nullopt);
-    bool HandlePotionPurchase(std::shared_ptr<Tile>& tile, std::shared_ptr<Player>& currentPlayer);
+    bool HandlePotionPurchase(Tile* tile, std::shared_ptr<Player>& currentPlayer);
 
     std::string GetCostText(Resources& cost);
     void ToggleShopPanelVisibility();
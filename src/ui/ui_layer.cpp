@@ -38,7 +38,9 @@ void UILayer::OnUpdate(float dt)
     for (const auto& element : m_UIElementStack)
         element->Draw();
 
+    Renderer2D::BeginScene(m_UICamera);
     Notification::OnUpdate(dt);
+    Renderer2D::EndScene();
 }
 
 void UILayer::OnEvent(Event& event)
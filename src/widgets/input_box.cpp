@@ -34,24 +34,17 @@ void InputBox::OnUpdate()
 
         if (Renderer2D::GetTextSize(m_Camera, m_Text, m_FontName).x * m_TextScale + m_TextHOffset > m_Size.x - m_TextHOffset)
         {
-            // NOTE: if text is longer than input box width, utilize stencil buffer to only display
+            // NOTE: if text is longer than input box width, clip it to only display
             // what can fit within the input box size adjusted for horizontal offset
             tooLong = true;
-            glClear(GL_STENCIL_BUFFER_BIT);
-            glStencilFunc(GL_ALWAYS, 1, 0xFF);
-            glStencilMask(0xFF);
-
-            Renderer2D::DrawQuad(m_Position, { m_Size.x - m_TextHOffset * 2.0f, m_Size.y }, glm::vec4(0.0f));
 
             hAlignment = HTextAlign::RIGHT;
             position = { m_Position.x + m_Size.x / 2.0f - m_TextHOffset, m_Position.y };
         }
 
+        // Clipping flushes the batch, so the background and border are drawn before it and the cursor after it
         if (tooLong)
-        {
-            glStencilFunc(GL_EQUAL, 1, 0xFF);
-            glStencilMask(0x00);
-        }
+            Renderer2D::BeginClip(m_Position, { m_Size.x - m_TextHOffset * 2.0f, m_Size.y });
 
         // Text inside of input box
         Renderer2D::DrawTextStr(
@@ -65,10 +58,7 @@ void InputBox::OnUpdate()
         );
 
         if (tooLong)
-        {
-            glStencilFunc(GL_ALWAYS, 1, 0xFF);
-            glStencilMask(0xFF);
-        }
+            Renderer2D::EndClip();
     }
 
     if (m_Focused)
@@ -6,10 +6,9 @@
 
 #include "util/util.h"
 #include "graphics/renderer.h"
+#include "core/application.h"
 #include "core/resource_manager.h"
 
-#include <GLFW/glfw3.h>
-
 glm::vec2 Notification::s_Position;
 float Notification::s_CloseIconSize;
 float Notification::s_BorderOffset;
@@ -238,20 +237,20 @@ std::string Notification::ParseTextToFit(const std::string& text)
 {
     std::string result;
     float notificationWidth = s_Config.Width - (s_BorderOffset * 2.0f);
-    int lastNewLineIndex = 0;
+    float lineWidth = 0.0f;
 
+    // Widths of single characters add up to the width of the line, so each one is measured only once
     for (size_t i = 0; i < text.size(); i++)
     {
-        std::string subText = text.substr(lastNewLineIndex, i + 1 - lastNewLineIndex);
-        auto subTextSize = Renderer2D::GetTextSize(s_Camera, subText, NOTIFICATION_FONT) * s_TextScale;
+        float charWidth = Renderer2D::GetTextSize(s_Camera, text.substr(i, 1), NOTIFICATION_FONT).x * s_TextScale;
+        lineWidth += charWidth;
 
-        if (subTextSize.x >= notificationWidth)
+        if (lineWidth >= notificationWidth)
         {
-            char lastChar = subText[subText.size() - 1];
-            if (lastChar != ' ' && lastChar != '\n')
+            if (text[i] != ' ' && text[i] != '\n')
                 result += '-';
             result += '\n';
-            lastNewLineIndex = i;
+            lineWidth = charWidth;
         }
 
         result += text[i];
@@ -324,5 +323,5 @@ void Notification::RecalculatePositionAndDirection()
 
 float Notification::GetTime()
 {
-    return (float)glfwGetTime() * 1000.0f;
+    return Application::Get().GetTime() * 1000.0f;
 }
@@ -0,0 +1,261 @@
+#include "balance_simulator.h"
+
+#include <limits>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+
+#include "thread_pool.h"
+
+BalanceSimulator::BalanceSimulator(const SimulationSettings& settings)
+    : m_Settings(settings)
+{
+    m_Settings.MaxBudget = std::max(m_Settings.MaxBudget, m_Settings.MinBudget);
+    BuildCompositions();
+}
+
+void BalanceSimulator::Run()
+{
+    size_t count = m_Compositions.size();
+    m_Results.assign(count * count, { 0.0, 0.0 });
+
+    // Every matchup writes only its own result, so workers never share data
+    ThreadPool pool(m_Settings.ThreadCount);
+    for (size_t attacker = 0; attacker < count; attacker++)
+    {
+        for (size_t defender = 0; defender < count; defender++)
+        {
+            pool.Submit([this, attacker, defender, count]() {
+                m_Results[attacker * count + defender] = SimulateMatchup(attacker, defender);
+            });
+        }
+    }
+
+    pool.Wait();
+}
+
+bool BalanceSimulator::WriteCsv(const std::string& directory) const
+{
+    auto writeMatrix = [this](const std::string& path, double MatchupResult::* value) {
+        std::ofstream file(path);
+        if (!file)
+        {
+            std::cerr << "BalanceSimulator::WriteCsv: could not open " << path << std::endl;
+            return false;
+        }
+
+        file << "attacker\\defender";
+        for (const auto& composition : m_Compositions)
+            file << ',' << composition.Name;
+        file << '\n';
+
+        file << std::fixed << std::setprecision(4);
+        size_t count = m_Compositions.size();
+        for (size_t attacker = 0; attacker < count; attacker++)
+        {
+            file << m_Compositions[attacker].Name;
+            for (size_t defender = 0; defender < count; defender++)
+                file << ',' << m_Results[attacker * count + defender].*value;
+            file << '\n';
+        }
+
+        return true;
+    };
+
+    if (!writeMatrix(directory + "/win_rates.csv", &MatchupResult::WinRate) ||
+        !writeMatrix(directory + "/cost_efficiency.csv", &MatchupResult::CostEfficiency))
+        return false;
+
+    std::ofstream file(directory + "/compositions.csv");
+    if (!file)
+    {
+        std::cerr << "BalanceSimulator::WriteCsv: could not open " << directory << "/compositions.csv" << std::endl;
+        return false;
+    }
+
+    file << "composition,building_level,average_unit_cost,building_cost\n";
+    file << std::fixed << std::setprecision(2);
+    for (const auto& composition : m_Compositions)
+    {
+        file << composition.Name << ',' << composition.BuildingLevel << ','
+             << composition.AverageUnitCost << ',' << composition.BuildingCost << '\n';
+    }
+
+    return true;
+}
+
+void BalanceSimulator::BuildCompositions()
+{
+    // Every unit type alone and every pair of types mixed evenly
+    std::vector<std::vector<UnitGroupType>> mixes;
+    for (int first = 0; first < (int)UnitGroupType::COUNT; first++)
+    {
+        mixes.push_back({ (UnitGroupType)first });
+        for (int second = first + 1; second < (int)UnitGroupType::COUNT; second++)
+            mixes.push_back({ (UnitGroupType)first, (UnitGroupType)second });
+    }
+
+    for (const auto& types : mixes)
+    {
+        bool needsBuilding = std::any_of(types.begin(), types.end(), [](UnitGroupType type) {
+            return UnitGroupDataMap[type].RequiredBuilding != BuildingType::NONE;
+        });
+
+        for (unsigned int level = 0; level <= m_Settings.MaxBuildingLevel; level++)
+        {
+            // Levels change nothing for units recruited without a building
+            if (level > 0 && !needsBuilding)
+                break;
+
+            ArmyComposition composition;
+            composition.Types = types;
+            composition.BuildingLevel = level;
+            composition.AverageUnitCost = 0.0f;
+            composition.BuildingCost = 0;
+
+            std::vector<BuildingType> buildings;
+            for (auto type : types)
+            {
+                composition.Name += (composition.Name.empty() ? "" : "+") + UnitGroupDataMap[type].TextureName;
+                composition.TypeStats.push_back(GetUnitStats(type, level));
+                composition.TypeCosts.push_back(GetUnitCost(type));
+                composition.AverageUnitCost += composition.TypeCosts.back() / (float)types.size();
+
+                BuildingType building = UnitGroupDataMap[type].RequiredBuilding;
+                if (building != BuildingType::NONE && std::find(buildings.begin(), buildings.end(), building) == buildings.end())
+                {
+                    buildings.push_back(building);
+                    composition.BuildingCost += GetBuildingCost(building, level);
+                }
+            }
+            composition.Name += "@" + std::to_string(level);
+
+            m_Compositions.push_back(composition);
+        }
+    }
+}
+
+MatchupResult BalanceSimulator::SimulateMatchup(size_t attackerIndex, size_t defenderIndex) const
+{
+    const ArmyComposition& attacker = m_Compositions[attackerIndex];
+    const ArmyComposition& defender = m_Compositions[defenderIndex];
+
+    // Each matchup draws from its own stream, so results do not depend on how tasks reach the threads
+    std::seed_seq seed = { (uint32_t)m_Settings.Seed, (uint32_t)(m_Settings.Seed >> 32), (uint32_t)attackerIndex, (uint32_t)defenderIndex };
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<int> budgetDistribution(m_Settings.MinBudget, m_Settings.MaxBudget);
+
+    std::vector<UnitStats> attackerUnits, defenderUnits;
+    std::vector<int> attackerCosts, defenderCosts;
+    BattleArmy attackerArmy, defenderArmy;
+
+    unsigned int wins = 0;
+    uint64_t attackerLostValue = 0;
+    uint64_t defenderLostValue = 0;
+
+    for (unsigned int battle = 0; battle < m_Settings.BattlesPerMatchup; battle++)
+    {
+        int budget = budgetDistribution(rng);
+        BuyArmy(attacker, budget, rng, attackerUnits, attackerCosts);
+        BuyArmy(defender, budget, rng, defenderUnits, defenderCosts);
+
+        // Units are linked to the local stats, dead ones are then recognized by their health
+        attackerArmy.Clear();
+        for (auto& unit : attackerUnits)
+            attackerArmy.Add(unit, &unit);
+        defenderArmy.Clear();
+        for (auto& unit : defenderUnits)
+            defenderArmy.Add(unit, &unit);
+
+        Battle::Simulate(attackerArmy, defenderArmy, m_Settings.DefenderTakesReducedDamage);
+        attackerArmy.WriteBack();
+        defenderArmy.WriteBack();
+
+        if (attackerArmy.GetTotalHealth() > 0)
+            wins++;
+
+        for (size_t i = 0; i < attackerUnits.size(); i++)
+        {
+            if (attackerUnits[i].Health <= 0)
+                attackerLostValue += attackerCosts[i];
+        }
+        for (size_t i = 0; i < defenderUnits.size(); i++)
+        {
+            if (defenderUnits[i].Health <= 0)
+                defenderLostValue += defenderCosts[i];
+        }
+    }
+
+    MatchupResult result;
+    result.WinRate = m_Settings.BattlesPerMatchup > 0 ? (double)wins / m_Settings.BattlesPerMatchup : 0.0;
+    if (attackerLostValue > 0)
+        result.CostEfficiency = (double)defenderLostValue / attackerLostValue;
+    else
+        result.CostEfficiency = defenderLostValue > 0 ? std::numeric_limits<double>::infinity() : 0.0;
+
+    return result;
+}
+
+void BalanceSimulator::BuyArmy(const ArmyComposition& composition, int budget, std::mt19937_64& rng,
+                               std::vector<UnitStats>& units, std::vector<int>& unitCosts)
+{
+    units.clear();
+    unitCosts.clear();
+
+    int spent = 0;
+    for (size_t i = 0; ; i++)
+    {
+        size_t type = i % composition.Types.size();
+        int cost = composition.TypeCosts[type];
+
+        // An army always has at least one unit, even when the budget is too small for it
+        if (spent + cost > budget && !units.empty())
+            break;
+
+        units.push_back(composition.TypeStats[type]);
+        unitCosts.push_back(cost);
+        spent += cost;
+    }
+
+    // Units fight by their position, so mixed armies are lined up in a random order
+    for (size_t i = units.size(); i > 1; i--)
+    {
+        size_t j = std::uniform_int_distribution<size_t>(0, i - 1)(rng);
+        std::swap(units[i - 1], units[j]);
+        std::swap(unitCosts[i - 1], unitCosts[j]);
+    }
+}
+
+UnitStats BalanceSimulator::GetUnitStats(UnitGroupType type, unsigned int buildingLevel)
+{
+    // Same upgrade Tile::CreateUnitGroup gives units recruited next to an upgraded building
+    UnitStats stats = UnitGroupDataMap[type].Stats;
+    if (buildingLevel > 0 && UnitGroupDataMap[type].RequiredBuilding != BuildingType::NONE)
+        stats = stats + (int)buildingLevel;
+
+    return stats;
+}
+
+int BalanceSimulator::GetUnitCost(UnitGroupType type)
+{
+    return SumResources(UnitGroupDataMap[type].Cost);
+}
+
+int BalanceSimulator::GetBuildingCost(BuildingType type, unsigned int level)
+{
+    Building building(type);
+    int cost = SumResources(BuildingDataMap[type].Cost);
+    for (unsigned int i = 0; i < level; i++)
+    {
+        cost += SumResources(building.GetUpgradeCost());
+        building.Upgrade();
+    }
+
+    return cost;
+}
+
+int BalanceSimulator::SumResources(const Resources& resources)
+{
+    return resources.Wood + resources.Rock + resources.Steel + resources.Gold;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <random>
+#include <cstdint>
+
+#include "game/unit.h"
+#include "game/battle.h"
+#include "game/building.h"
+
+struct SimulationSettings
+{
+    unsigned int BattlesPerMatchup = 1000;
+    // level of the buildings required by the units, every level up to this one is swept
+    unsigned int MaxBuildingLevel = 3;
+    // both sides spend the same amount of resources, drawn anew for every battle
+    int MinBudget = 20;
+    int MaxBudget = 200;
+    bool DefenderTakesReducedDamage = false;
+    uint64_t Seed = 1;
+    // 0 uses every hardware thread
+    unsigned int ThreadCount = 0;
+};
+
+// Unit types bought in turn until the budget runs out, with their required buildings upgraded to a level
+struct ArmyComposition
+{
+    std::string Name;
+    std::vector<UnitGroupType> Types;
+    // stats and cost of each of the types, looked up once so workers only read plain vectors
+    std::vector<UnitStats> TypeStats;
+    std::vector<int> TypeCosts;
+    unsigned int BuildingLevel;
+    float AverageUnitCost;
+    int BuildingCost;
+};
+
+struct MatchupResult
+{
+    double WinRate;
+    // resources worth of defending units destroyed per resource worth of attacking units lost
+    double CostEfficiency;
+};
+
+// Plays every composition against every other one many times with the rules of Battle and the
+// stats and costs of UnitGroupDataMap and BuildingDataMap, spreading the matchups over all cores
+class BalanceSimulator
+{
+public:
+    BalanceSimulator(const SimulationSettings& settings);
+    ~BalanceSimulator() = default;
+
+    void Run();
+    // Writes win_rates.csv, cost_efficiency.csv and compositions.csv into the directory
+    bool WriteCsv(const std::string& directory) const;
+
+    inline const std::vector<ArmyComposition>& GetCompositions() const { return m_Compositions; }
+    inline uint64_t GetSimulatedBattleCount() const { return (uint64_t)m_Results.size() * m_Settings.BattlesPerMatchup; }
+
+private:
+    void BuildCompositions();
+    MatchupResult SimulateMatchup(size_t attackerIndex, size_t defenderIndex) const;
+    // The cost of every bought unit is stored next to its stats
+    static void BuyArmy(const ArmyComposition& composition, int budget, std::mt19937_64& rng,
+                        std::vector<UnitStats>& units, std::vector<int>& unitCosts);
+
+    static UnitStats GetUnitStats(UnitGroupType type, unsigned int buildingLevel);
+    static int GetUnitCost(UnitGroupType type);
+    static int GetBuildingCost(BuildingType type, unsigned int level);
+    static int SumResources(const Resources& resources);
+
+private:
+    SimulationSettings m_Settings;
+    std::vector<ArmyComposition> m_Compositions;
+    // attacker compositions by rows, defender compositions by columns
+    std::vector<MatchupResult> m_Results;
+};
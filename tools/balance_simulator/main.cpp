@@ -0,0 +1,68 @@
+#include <chrono>
+#include <string>
+#include <cstring>
+#include <iostream>
+
+#include "balance_simulator.h"
+
+static void PrintUsage(const char* program)
+{
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --battles <n>       battles simulated per matchup (default 1000)\n"
+              << "  --levels <n>        highest building upgrade level swept (default 3)\n"
+              << "  --min-budget <n>    smallest amount of resources spent per army (default 20)\n"
+              << "  --max-budget <n>    largest amount of resources spent per army (default 200)\n"
+              << "  --reduce-damage     defenders have the reduce damage potion applied\n"
+              << "  --seed <n>          seed of the random streams (default 1)\n"
+              << "  --threads <n>       worker threads, 0 uses every core (default 0)\n"
+              << "  --output <dir>      directory the csv files are written to (default .)\n";
+}
+
+int main(int argc, char* argv[])
+{
+    SimulationSettings settings;
+    std::string outputDirectory = ".";
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--battles") == 0 && hasValue)
+            settings.BattlesPerMatchup = std::stoul(argv[++i]);
+        else if (std::strcmp(argv[i], "--levels") == 0 && hasValue)
+            settings.MaxBuildingLevel = std::stoul(argv[++i]);
+        else if (std::strcmp(argv[i], "--min-budget") == 0 && hasValue)
+            settings.MinBudget = std::stoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--max-budget") == 0 && hasValue)
+            settings.MaxBudget = std::stoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--reduce-damage") == 0)
+            settings.DefenderTakesReducedDamage = true;
+        else if (std::strcmp(argv[i], "--seed") == 0 && hasValue)
+            settings.Seed = std::stoull(argv[++i]);
+        else if (std::strcmp(argv[i], "--threads") == 0 && hasValue)
+            settings.ThreadCount = std::stoul(argv[++i]);
+        else if (std::strcmp(argv[i], "--output") == 0 && hasValue)
+            outputDirectory = argv[++i];
+        else
+        {
+            PrintUsage(argv[0]);
+            return std::strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    BalanceSimulator simulator(settings);
+
+    auto start = std::chrono::steady_clock::now();
+    simulator.Run();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    uint64_t battles = simulator.GetSimulatedBattleCount();
+    std::cout << "Simulated " << battles << " battles between " << simulator.GetCompositions().size()
+              << " compositions in " << elapsed.count() << "s ("
+              << (elapsed.count() > 0.0 ? battles / elapsed.count() : 0.0) << " battles/s)" << std::endl;
+
+    if (!simulator.WriteCsv(outputDirectory))
+        return 1;
+
+    std::cout << "Results written to " << outputDirectory << std::endl;
+    return 0;
+}
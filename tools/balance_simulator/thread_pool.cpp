@@ -0,0 +1,73 @@
+#include "thread_pool.h"
+
+ThreadPool::ThreadPool(unsigned int threadCount)
+    : m_RunningTasks(0), m_Stopping(false)
+{
+    if (threadCount == 0)
+        threadCount = std::thread::hardware_concurrency();
+    if (threadCount == 0)
+        threadCount = 1;
+
+    m_Workers.reserve(threadCount);
+    for (unsigned int i = 0; i < threadCount; i++)
+        m_Workers.emplace_back(&ThreadPool::WorkerLoop, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stopping = true;
+    }
+    m_TaskAvailable.notify_all();
+
+    for (auto& worker : m_Workers)
+        worker.join();
+}
+
+void ThreadPool::Submit(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Tasks.push(std::move(task));
+    }
+    m_TaskAvailable.notify_one();
+}
+
+void ThreadPool::Wait()
+{
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_TasksFinished.wait(lock, [this]() {
+        return m_Tasks.empty() && m_RunningTasks == 0;
+    });
+}
+
+void ThreadPool::WorkerLoop()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_TaskAvailable.wait(lock, [this]() {
+                return m_Stopping || !m_Tasks.empty();
+            });
+
+            // Queued tasks are still finished when the pool is stopping
+            if (m_Tasks.empty())
+                return;
+
+            task = std::move(m_Tasks.front());
+            m_Tasks.pop();
+            m_RunningTasks++;
+        }
+
+        task();
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_RunningTasks--;
+        }
+        m_TasksFinished.notify_all();
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+
+// Fixed set of worker threads taking queued tasks in the order they were submitted
+class ThreadPool
+{
+public:
+    // 0 starts one worker per hardware thread
+    ThreadPool(unsigned int threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void Submit(std::function<void()> task);
+    // Blocks until every submitted task has finished
+    void Wait();
+
+    inline unsigned int GetThreadCount() const { return m_Workers.size(); }
+
+private:
+    void WorkerLoop();
+
+private:
+    std::vector<std::thread> m_Workers;
+    std::queue<std::function<void()>> m_Tasks;
+    std::mutex m_Mutex;
+    std::condition_variable m_TaskAvailable;
+    std::condition_variable m_TasksFinished;
+    unsigned int m_RunningTasks;
+    bool m_Stopping;
+};
@@ -0,0 +1,131 @@
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <iostream>
+
+#include "core/application.h"
+#include "graphics/renderer.h"
+#include "graphics/render_backend.h"
+#include "game/map_manager.h"
+
+// frames run before recording, the first ones start the game and fill the terrain and minimap caches
+#define WARMUP_FRAME_COUNT 3
+// seconds between two frames
+#define FRAME_TIME (1.0f / 60.0f)
+
+static void PrintUsage(const char* program)
+{
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --map <name>        map the game is started on (default simple)\n"
+              << "  --width <n>         width of the headless window in pixels (default 1920)\n"
+              << "  --height <n>        height of the headless window in pixels (default 1080)\n"
+              << "Run from the repository root, assets are loaded relative to it\n";
+}
+
+// Places two human players on the first tiles they can own
+static std::vector<PlayerDTO> CreatePlayers(const std::string& mapName)
+{
+    GameMapManager manager(mapName);
+    std::vector<PlayerDTO> players;
+
+    for (auto& tile : manager.GetGameMap()->GetTiles())
+    {
+        if (!tile.AssetsCanExist())
+            continue;
+
+        bool first = players.empty();
+        players.emplace_back(PlayerDTO(first ? "Foo" : "Bar", first ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 0.0f, 1.0f),
+                                       { glm::vec2(tile.GetCoords()) }));
+        if (players.size() == 2)
+            break;
+    }
+
+    return players;
+}
+
+// Runs one frame of the application into a command list and replays it through the null backend
+static void RecordFrame(Application& application, float time, NullRenderBackend& backend)
+{
+    auto commandList = std::make_shared<RenderCommandList>();
+
+    Renderer2D::BeginRecording(commandList);
+    application.RunFrame(time);
+    Renderer2D::EndRecording();
+
+    backend.Reset();
+    backend.Execute(*commandList);
+}
+
+static bool Check(bool condition, const std::string& message)
+{
+    if (!condition)
+        std::cout << "FAILED: " << message << std::endl;
+
+    return condition;
+}
+
+int main(int argc, char* argv[])
+{
+    std::string mapName = "simple";
+    WindowProps windowProps("RenderCheck", 1920, 1080, true);
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--map") == 0 && hasValue)
+            mapName = argv[++i];
+        else if (std::strcmp(argv[i], "--width") == 0 && hasValue)
+            windowProps.Width = std::stoul(argv[++i]);
+        else if (std::strcmp(argv[i], "--height") == 0 && hasValue)
+            windowProps.Height = std::stoul(argv[++i]);
+        else
+        {
+            PrintUsage(argv[0]);
+            return std::strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    Application application(windowProps);
+
+    std::vector<PlayerDTO> players = CreatePlayers(mapName);
+    if (!Check(players.size() == 2, "map " + mapName + " has no room for two players"))
+        return 1;
+
+    application.StartNewGame({ mapName, players });
+
+    float time = 0.0f;
+    for (int i = 0; i < WARMUP_FRAME_COUNT; i++)
+    {
+        time += FRAME_TIME;
+        application.RunFrame(time);
+    }
+
+    time += FRAME_TIME;
+    NullRenderBackend frame;
+    RecordFrame(application, time, frame);
+    Renderer2D::Statistics stats = Renderer2D::GetStats();
+
+    // Nothing moves while no time passes, so the same frame has to be recorded again
+    NullRenderBackend repeatedFrame;
+    RecordFrame(application, time, repeatedFrame);
+
+    std::cout << "Recorded " << frame.GetCommands().size() << " commands, " << frame.GetDrawCount() << " draw calls, "
+              << frame.GetQuadCount() << " quads" << std::endl;
+
+    bool passed = true;
+    passed &= Check(frame.GetDrawCount() > 0, "recorded frame has no draw calls");
+    passed &= Check(frame.GetDrawCount() == stats.DrawCalls,
+                    "recorded " + std::to_string(frame.GetDrawCount()) + " draw calls, renderer counted " + std::to_string(stats.DrawCalls));
+    passed &= Check(frame.GetQuadCount() == stats.QuadCount,
+                    "recorded " + std::to_string(frame.GetQuadCount()) + " quads, renderer counted " + std::to_string(stats.QuadCount));
+
+    int difference = frame.FindFirstDifference(repeatedFrame);
+    passed &= Check(difference == -1, "repeated frame differs from command " + std::to_string(difference) + " on");
+
+    if (!passed)
+        return 1;
+
+    std::cout << "Render check passed" << std::endl;
+    return 0;
+}